@@ -0,0 +1,94 @@
+/*
+  event_log_bench
+
+  Measures the cost of EventLog::log() in core clock cycles, both when the
+  record is appended and when it is dropped because the ring is full. Cycles
+  are counted with the SysTick timer, which counts down at the core clock on
+  every Cortex-M0+. Results are written to the serial port.
+
+  This example code is in the public domain.
+*/
+
+#include "EventLog.h"
+
+/*---------------------------------------------------------------------------*/
+
+constexpr int BATCHES = 1000;
+constexpr int BATCH_SIZE = cp_chrono::EventLog::CAPACITY - 1;
+
+cp_chrono::EventLog event_log;
+
+// Accepts and discards everything, so draining costs no serial time.
+class NullPrint : public Print
+{
+public:
+    size_t write(uint8_t) override { return 1; }
+    int availableForWrite() override { return 1024; }
+};
+
+NullPrint null_print;
+
+void discard_record(Print&, const cp_chrono::EventLog::Record&) { }
+
+// Returns the cycles elapsed since start, allowing for one SysTick reload.
+uint32_t cycles_since(uint32_t start)
+{
+    uint32_t now = SysTick->VAL;
+    return start >= now ? start - now : start + SysTick->LOAD + 1 - now;
+}
+
+// Returns the total cycles taken by BATCHES batches of BATCH_SIZE calls.
+template <typename Call>
+uint64_t time_batches(bool drain_between, Call call)
+{
+    uint64_t total = 0;
+    for (int b = 0; b < BATCHES; ++b) {
+        if (drain_between)
+            event_log.drain(null_print, discard_record);
+        noInterrupts();
+        uint32_t start = SysTick->VAL;
+        for (int i = 0; i < BATCH_SIZE; ++i)
+            call(i);
+        total += cycles_since(start);
+        interrupts();
+    }
+    return total;
+}
+
+void print_cycles(const char* name, uint64_t total, uint64_t overhead)
+{
+    Serial.print(name);
+    Serial.print(": ");
+    Serial.print(float(total - overhead) / (BATCHES * BATCH_SIZE));
+    Serial.println(" cycles per call");
+}
+
+/*---------------------------------------------------------------------------*/
+
+void setup()
+{
+    Serial.begin(115200);
+    while (!Serial)
+        delay(10);
+
+    volatile int32_t arg = 0;
+    auto overhead = time_batches(true, [&](int i) { arg = i; });
+    auto append = time_batches(true, [&](int i) { event_log.log(1, i, arg, i, 0); });
+
+    // Fill the ring so every call takes the drop path
+    while (event_log.pending() < cp_chrono::EventLog::CAPACITY)
+        event_log.log(1, 0);
+    auto drop = time_batches(false, [&](int i) { event_log.log(1, i, arg, i, 0); });
+
+    Serial.print("F_CPU: ");
+    Serial.println(F_CPU);
+    print_cycles("log() appending", append, overhead);
+    print_cycles("log() dropping", drop, overhead);
+}
+
+void loop()
+{
+    delay(1000);
+}
+
+/*---------------------------------------------------------------------------*/
@@ -0,0 +1,132 @@
+/*
+  pixel_kernels_bench
+
+  Checks that the word-parallel pixel kernels give the same results as the
+  FastLED functions they replace, and times both on buffers of 10, 24 and 60
+  pixels. Results are written to the serial port.
+
+  This example code is in the public domain.
+*/
+
+#include "PixelKernels.h"
+#include <FastLED.h>
+
+/*---------------------------------------------------------------------------*/
+
+namespace pk = cp_chrono::pixel_kernels;
+
+constexpr int MAX_PIXELS = 60;
+constexpr int ITERATIONS = 1000;
+
+alignas(4) CRGB kernel_pixels[MAX_PIXELS + 3];
+alignas(4) CRGB fastled_pixels[MAX_PIXELS + 3];
+
+void randomize(int num_pixels)
+{
+    for (int i = 0; i < num_pixels; ++i)
+        kernel_pixels[i] = fastled_pixels[i] = CRGB(random8(), random8(), random8());
+}
+
+bool same(int num_pixels)
+{
+    return memcmp(kernel_pixels, fastled_pixels, num_pixels * sizeof(CRGB)) == 0;
+}
+
+// Compares every fade amount and a range of colors at each buffer offset,
+// which exercises the unaligned head and tail handling.
+int count_mismatches()
+{
+    int mismatches = 0;
+    for (int offset = 0; offset < 4; ++offset) {
+        CRGB* k = kernel_pixels + offset;
+        CRGB* f = fastled_pixels + offset;
+        int n = MAX_PIXELS - offset;
+        for (int amount = 0; amount < 256; ++amount) {
+            randomize(MAX_PIXELS + 3);
+            pk::fade_to_black_by(k, n, amount);
+            fadeToBlackBy(f, n, amount);
+            mismatches += !same(MAX_PIXELS + 3);
+
+            randomize(MAX_PIXELS + 3);
+            CRGB color(random8(), random8(), random8());
+            pk::add(k, n, color);
+            for (int i = 0; i < n; ++i)
+                f[i] += color;
+            mismatches += !same(MAX_PIXELS + 3);
+
+            randomize(MAX_PIXELS + 3);
+            pk::fill_solid(k, n, CRGB(amount, amount, amount));
+            fill_solid(f, n, CRGB(amount, amount, amount));
+            mismatches += !same(MAX_PIXELS + 3);
+        }
+    }
+    return mismatches;
+}
+
+void print_timing(const char* name, int num_pixels, uint32_t kernel_us, uint32_t fastled_us)
+{
+    Serial.print(name);
+    Serial.print(" x");
+    Serial.print(num_pixels);
+    Serial.print(": kernel ");
+    Serial.print(kernel_us * 1000.0 / ITERATIONS);
+    Serial.print(" ns, FastLED ");
+    Serial.print(fastled_us * 1000.0 / ITERATIONS);
+    Serial.println(" ns");
+}
+
+void benchmark(int num_pixels)
+{
+    randomize(num_pixels);
+    uint32_t start = micros();
+    for (int i = 0; i < ITERATIONS; ++i)
+        pk::fade_to_black_by(kernel_pixels, num_pixels, 40);
+    uint32_t kernel_us = micros() - start;
+    start = micros();
+    for (int i = 0; i < ITERATIONS; ++i)
+        fadeToBlackBy(fastled_pixels, num_pixels, 40);
+    print_timing("fade", num_pixels, kernel_us, micros() - start);
+
+    CRGB color(1, 2, 3);
+    start = micros();
+    for (int i = 0; i < ITERATIONS; ++i)
+        pk::add(kernel_pixels, num_pixels, color);
+    kernel_us = micros() - start;
+    start = micros();
+    for (int i = 0; i < ITERATIONS; ++i) {
+        for (int j = 0; j < num_pixels; ++j)
+            fastled_pixels[j] += color;
+    }
+    print_timing("add", num_pixels, kernel_us, micros() - start);
+
+    start = micros();
+    for (int i = 0; i < ITERATIONS; ++i)
+        pk::fill_solid(kernel_pixels, num_pixels, 0);
+    kernel_us = micros() - start;
+    start = micros();
+    for (int i = 0; i < ITERATIONS; ++i)
+        fill_solid(fastled_pixels, num_pixels, 0);
+    print_timing("fill", num_pixels, kernel_us, micros() - start);
+}
+
+/*---------------------------------------------------------------------------*/
+
+void setup()
+{
+    Serial.begin(115200);
+    while (!Serial)
+        delay(10);
+
+    Serial.print("Mismatches: ");
+    Serial.println(count_mismatches());
+
+    for (int num_pixels : { 10, 24, 60 })
+        benchmark(num_pixels);
+}
+
+void loop()
+{
+    delay(1000);
+}
+
+/*---------------------------------------------------------------------------*/
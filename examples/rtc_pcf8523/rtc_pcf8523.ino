@@ -8,6 +8,8 @@
 */
 
 #include "CPChronometer.h"
+#include "CircuitPlaygroundHardware.h"
+#include "EventLog.h"
 #include <Adafruit_CircuitPlayground.h>
 #include <FastLED.h>
 #include <FlashAsEEPROM.h>
@@ -15,11 +17,28 @@
 
 /*---------------------------------------------------------------------------*/
 
-cp_chrono::CPChronometer cpc;
+cp_chrono::CircuitPlaygroundHardware hardware;
+cp_chrono::CPChronometer cpc(hardware);
+cp_chrono::EventLog event_log;
+
+enum LogEvent : uint8_t {
+    LOG_CLOCK_STATUS, // args: display time (s), drift (ms), clock offset (ms)
+    LOG_ALARM,        // args: minute of day
+    LOG_ALARM_FAILED, // args: minute of day
+    LOG_POWER,        // args: power category, charge (uAh), average current (uA)
+};
 
 int32_t stored_offset = 0;
+uint16_t stored_alarms_revision = 0;
+
+// Flash layout: the clock offset, followed by the alarm count and the
+// alarms' minutes of the day.
+constexpr int ALARM_COUNT_ADDR = sizeof(stored_offset);
+constexpr int ALARMS_ADDR = ALARM_COUNT_ADDR + 1;
+
 RTC_PCF8523 rtc;
 int64_t slew = 0;
+int64_t initial_slew = 0;
 
 void init_rtc()
 {
@@ -33,10 +52,11 @@ void init_rtc()
     rtc.start();
 
     if (!EEPROM.isValid()) {
-        // If invalid, initialize the stored offset to 0
+        // If invalid, initialize the stored offset to 0 and clear the alarms
         for (int i = 0; i < sizeof(stored_offset); ++i) {
             EEPROM.write(i, 0);
         }
+        EEPROM.write(ALARM_COUNT_ADDR, 0);
         EEPROM.commit();
     } else {
         for (int i = 0; i < sizeof(stored_offset); ++i) {
@@ -46,6 +66,64 @@ void init_rtc()
         Serial.print("Read stored clock offset ");
         Serial.println(stored_offset);
         cpc.increase_clock_offset(stored_offset);
+
+        int num_alarms = EEPROM.read(ALARM_COUNT_ADDR);
+        if (num_alarms > cp_chrono::AlarmSchedule::MAX_ALARMS)
+            num_alarms = 0;
+        for (int i = 0; i < num_alarms; ++i) {
+            auto addr = ALARMS_ADDR + i * 2;
+            cpc.alarms().add(EEPROM.read(addr) + (EEPROM.read(addr + 1) << 8));
+        }
+        Serial.print("Read stored alarms ");
+        Serial.println(cpc.alarms().size());
+    }
+    stored_alarms_revision = cpc.alarms().revision();
+}
+
+void store_alarms()
+{
+    auto& alarms = cpc.alarms();
+    EEPROM.write(ALARM_COUNT_ADDR, alarms.size());
+    for (int i = 0; i < alarms.size(); ++i) {
+        // Little-endian
+        EEPROM.write(ALARMS_ADDR + i * 2, alarms.alarm(i) & 0xFF);
+        EEPROM.write(ALARMS_ADDR + i * 2 + 1, alarms.alarm(i) >> 8);
+    }
+    stored_alarms_revision = alarms.revision();
+}
+
+// Reads alarm commands from the serial port without blocking:
+//   +HH:MM  adds a daily alarm
+//   -HH:MM  removes a daily alarm
+//   ?       lists the alarms
+void read_alarm_command(int64_t now)
+{
+    static char command[8];
+    static int length = 0;
+
+    while (Serial.available()) {
+        char c = Serial.read();
+        if (c != '\n' && c != '\r') {
+            if (length < sizeof(command) - 1)
+                command[length++] = c;
+            continue;
+        }
+        command[length] = 0;
+        length = 0;
+
+        auto& alarms = cpc.alarms();
+        if (command[0] == '?') {
+            for (int i = 0; i < alarms.size(); ++i)
+                event_log.log(LOG_ALARM, now, alarms.alarm(i));
+        } else if (command[0] == '+' || command[0] == '-') {
+            int hour = 0, minute = 0;
+            if (sscanf(command + 1, "%d:%d", &hour, &minute) != 2
+                || hour < 0 || hour > 23 || minute < 0 || minute > 59)
+                continue;
+            uint16_t minute_of_day = hour * 60 + minute;
+            bool ok = command[0] == '+' ? alarms.add(minute_of_day) : alarms.remove(minute_of_day);
+            event_log.log(ok ? LOG_ALARM : LOG_ALARM_FAILED, now, minute_of_day);
+        }
     }
 }
 
@@ -60,6 +138,7 @@ int64_t now_callback()
         last_rtc_sync_tm = ((int64_t)rtc.now().unixtime()) * 1000;
         last_millis_sync_tm = millis_now;
         slew = last_rtc_sync_tm - last_millis_sync_tm;
+        initial_slew = slew;
     } else {
         EVERY_N_SECONDS(100) {
             int64_t rtc_tm = ((int64_t)rtc.now().unixtime()) * 1000;
@@ -81,6 +160,55 @@ void halt_and_catch_fire(const char* message)
         delay(100);
 }
 
+void print_two_digits(Print& out, uint8_t value)
+{
+    if (value < 10)
+        out.print('0');
+    out.print(value, DEC);
+}
+
+void format_log_record(Print& out, const cp_chrono::EventLog::Record& record)
+{
+    switch (record.event) {
+    case LOG_CLOCK_STATUS: {
+        DateTime dt(uint32_t(record.args[0]));
+        print_two_digits(out, dt.hour());
+        out.print(':');
+        print_two_digits(out, dt.minute());
+        out.print(':');
+        print_two_digits(out, dt.second());
+        out.print(" (drift: ");
+        out.print(record.args[1]);
+        out.print(" ms)");
+        out.print(" (offset: ");
+        out.print(record.args[2]);
+        out.println(")");
+        break;
+    }
+    case LOG_ALARM:
+    case LOG_ALARM_FAILED:
+        out.print(record.event == LOG_ALARM ? "alarm " : "alarm command failed ");
+        print_two_digits(out, record.args[0] / 60);
+        out.print(':');
+        print_two_digits(out, record.args[0] % 60);
+        out.println();
+        break;
+    case LOG_POWER:
+        out.print("power ");
+        out.print(cp_chrono::PowerMonitor::category_name(cp_chrono::PowerMonitor::Category(record.args[0])));
+        out.print(": ");
+        out.print(record.args[1]);
+        out.print(" uAh, average ");
+        out.print(record.args[2]);
+        out.println(" uA");
+        break;
+    default:
+        out.print("unknown event ");
+        out.println(record.event);
+        break;
+    }
+}
+
 /*---------------------------------------------------------------------------*/
 
 void setup()
@@ -93,8 +221,6 @@ void setup()
 
     init_rtc();
 
-    FastLED.setBrightness(6);
-
     cpc.reset((*now_callback)());
 }
 
@@ -105,46 +231,49 @@ void loop()
     // The CPChronometer handles all the button input and LED output
     cpc.update(now);
 
-    // Once per minute, see if the user has changed the clock offset from
-    // what is stored in flash and update if necessary.
+    read_alarm_command(now);
+
+    // Once per minute, see if the user has changed the clock offset or the
+    // alarms from what is stored in flash and update if necessary.
     EVERY_N_SECONDS(60) {
+        bool changed = false;
         if (stored_offset != cpc.clock_offset()) {
             stored_offset = cpc.clock_offset();
             for (int i = 0; i < sizeof(stored_offset); ++i) {
                 // Little-endian
                 EEPROM.write(i, (stored_offset & (0xFF << (i * 8))) >> (i * 8));
             }
-            EEPROM.commit();
+            changed = true;
+        }
+        if (stored_alarms_revision != cpc.alarms().revision()) {
+            store_alarms();
+            changed = true;
         }
+        if (changed)
+            EEPROM.commit();
     }
 
-    // Write the display time to the serial port periodically for debugging
+    // Record the display time periodically for debugging, the record is
+    // formatted and written to the serial port once there is room for it.
+    // The slew itself is the RTC's epoch in ms and too large for a record, so
+    // the drift between millis() and the RTC since the first sync is logged.
     EVERY_N_SECONDS(5) {
-        DateTime dt_now(cpc.clock_display_tm(now) / 1000);
-        if (dt_now.hour() < 10)
-            Serial.print('0');
-        Serial.print(dt_now.hour(), DEC);
-        Serial.print(':');
-        if (dt_now.minute() < 10)
-            Serial.print('0');
-        Serial.print(dt_now.minute(), DEC);
-        Serial.print(':');
-        if (dt_now.second() < 10)
-            Serial.print('0');
-        Serial.print(dt_now.second(), DEC);
-        Serial.print(" (slew: ");
-        Serial.print(uint32_t(slew / 1000));
-        Serial.print(".");
-        Serial.print(int(slew % 1000));
-        Serial.print(slew);
-        Serial.print(")");
-        Serial.print(" (offset: ");
-        Serial.print(cpc.clock_offset());
-        Serial.print(")");
-        Serial.println();
+        event_log.log(LOG_CLOCK_STATUS, now, cpc.clock_display_tm(now) / 1000, int32_t(slew - initial_slew), cpc.clock_offset());
+    }
+    // Record the NeoPixel power accounting less often
+    EVERY_N_SECONDS(60) {
+        for (int i = 0; i < cp_chrono::PowerMonitor::NUM_CATEGORIES; ++i) {
+            auto& totals = cpc.power_monitor().totals(cp_chrono::PowerMonitor::Category(i));
+            event_log.log(LOG_POWER, now, i, totals.charge_uah(), totals.average_ua());
+        }
     }
+    event_log.drain(Serial, format_log_record);
 
-    FastLED.delay(1000 / 120);
+    // The chronometer shows the NeoPixels itself at its own brightness, so a
+    // plain delay is used rather than FastLED.delay(), which would resend
+    // them at FastLED's global brightness. The interval drops to a slow tick
+    // while the display is blanked.
+    delay(cpc.frame_interval_ms());
 }
 
 /*---------------------------------------------------------------------------*/
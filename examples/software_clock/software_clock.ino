@@ -8,13 +8,22 @@
 */
 
 #include "CPChronometer.h"
+#include "CircuitPlaygroundHardware.h"
+#include "EventLog.h"
 #include <Adafruit_CircuitPlayground.h>
 #include <FastLED.h>
 #include <RTClib.h>
 
 /*---------------------------------------------------------------------------*/
 
-cp_chrono::CPChronometer cpc;
+cp_chrono::CircuitPlaygroundHardware hardware;
+cp_chrono::CPChronometer cpc(hardware);
+cp_chrono::EventLog event_log;
+
+enum LogEvent : uint8_t {
+    LOG_CLOCK_STATUS, // args: display time (s), clock offset (ms)
+    LOG_POWER,        // args: power category, charge (uAh), average current (uA)
+};
 
 int64_t now_callback()
 {
@@ -22,6 +31,44 @@ int64_t now_callback()
     return offset + millis();
 }
 
+void print_two_digits(Print& out, uint8_t value)
+{
+    if (value < 10)
+        out.print('0');
+    out.print(value, DEC);
+}
+
+void format_log_record(Print& out, const cp_chrono::EventLog::Record& record)
+{
+    switch (record.event) {
+    case LOG_CLOCK_STATUS: {
+        DateTime dt(uint32_t(record.args[0]));
+        print_two_digits(out, dt.hour());
+        out.print(':');
+        print_two_digits(out, dt.minute());
+        out.print(':');
+        print_two_digits(out, dt.second());
+        out.print(" (offset: ");
+        out.print(record.args[1]);
+        out.println(")");
+        break;
+    }
+    case LOG_POWER:
+        out.print("power ");
+        out.print(cp_chrono::PowerMonitor::category_name(cp_chrono::PowerMonitor::Category(record.args[0])));
+        out.print(": ");
+        out.print(record.args[1]);
+        out.print(" uAh, average ");
+        out.print(record.args[2]);
+        out.println(" uA");
+        break;
+    default:
+        out.print("unknown event ");
+        out.println(record.event);
+        break;
+    }
+}
+
 /*---------------------------------------------------------------------------*/
 
 void setup()
@@ -32,8 +79,6 @@ void setup()
 
     cpc.begin();
 
-    FastLED.setBrightness(6);
-
     cpc.reset((*now_callback)());
 }
 
@@ -44,27 +89,25 @@ void loop()
     // The CPChronometer handles all the button input and LED output
     cpc.update(now);
 
-    // Write the display time to the serial port periodically for debugging
+    // Record the display time periodically for debugging, the record is
+    // formatted and written to the serial port once there is room for it.
     EVERY_N_SECONDS(5) {
-        DateTime dt_now(cpc.clock_display_tm(now) / 1000);
-        if (dt_now.hour() < 10)
-            Serial.print('0');
-        Serial.print(dt_now.hour(), DEC);
-        Serial.print(':');
-        if (dt_now.minute() < 10)
-            Serial.print('0');
-        Serial.print(dt_now.minute(), DEC);
-        Serial.print(':');
-        if (dt_now.second() < 10)
-            Serial.print('0');
-        Serial.print(dt_now.second(), DEC);
-        Serial.print(" (offset: ");
-        Serial.print(cpc.clock_offset());
-        Serial.print(")");
-        Serial.println();
+        event_log.log(LOG_CLOCK_STATUS, now, cpc.clock_display_tm(now) / 1000, cpc.clock_offset());
+    }
+    // Record the NeoPixel power accounting less often
+    EVERY_N_SECONDS(60) {
+        for (int i = 0; i < cp_chrono::PowerMonitor::NUM_CATEGORIES; ++i) {
+            auto& totals = cpc.power_monitor().totals(cp_chrono::PowerMonitor::Category(i));
+            event_log.log(LOG_POWER, now, i, totals.charge_uah(), totals.average_ua());
+        }
     }
+    event_log.drain(Serial, format_log_record);
 
-    FastLED.delay(1000 / 120);
+    // The chronometer shows the NeoPixels itself at its own brightness, so a
+    // plain delay is used rather than FastLED.delay(), which would resend
+    // them at FastLED's global brightness. The interval drops to a slow tick
+    // while the display is blanked.
+    delay(cpc.frame_interval_ms());
 }
 
 /*---------------------------------------------------------------------------*/
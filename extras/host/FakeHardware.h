@@ -0,0 +1,98 @@
+/*
+    Copyright 2023 Zach Vonler
+
+    This file is part of CircuitPlaygroundChronometer.
+
+    CircuitPlaygroundChronometer is free software: you can redistribute it
+    and/or modify it under the terms of the GNU General Public License as
+    published by the Free Software Foundation, either version 3 of the License,
+    or (at your option) any later version.
+
+    CircuitPlaygroundChronometer is distributed in the hope that it will be
+    useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General
+    Public License for more details.
+
+    You should have received a copy of the GNU General Public License along with
+    CircuitPlaygroundChronometer.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef fake_hardware_h
+#define fake_hardware_h
+
+#include "HardwareContext.h"
+
+namespace cp_chrono {
+
+/*---------------------------------------------------------------------------*/
+
+/**
+ * A scriptable HardwareContext for running chronometers on the host. Inputs
+ * are set directly by the test or simulation driving the chronometer, and
+ * outputs are recorded for it to inspect.
+ */
+class FakeHardware : public HardwareContext
+{
+public:
+    // Inputs
+    bool switch_on = true;
+    float accel_x = 0;
+    float accel_y = 0;
+    float accel_z = 9.8;
+    Gesture next_gesture = NO_GESTURE; // Returned by the next update_gestures()
+    bool buttons_both_pressed = false;
+    uint32_t button_duration = 0;
+    uint32_t left_button_duration = 0;
+    uint32_t right_button_duration = 0;
+
+    // Outputs
+    CRGB* pixels = nullptr;
+    int num_pixels = 0;
+    CRGB correction;
+    uint32_t shows = 0;
+    uint8_t last_brightness = 0;
+    bool indicator = false;
+    uint32_t tones = 0;
+
+    void begin(CRGB* p, int n, CRGB c) override
+    {
+        pixels = p;
+        num_pixels = n;
+        correction = c;
+    }
+
+    void show_leds(uint8_t brightness) override
+    {
+        ++shows;
+        last_brightness = brightness;
+    }
+
+    void set_indicator(bool on) override { indicator = on; }
+    void play_tone(uint16_t, uint16_t) override { ++tones; }
+    bool slide_switch() override { return switch_on; }
+
+    void read_acceleration(float& x, float& y, float& z) override
+    {
+        x = accel_x;
+        y = accel_y;
+        z = accel_z;
+    }
+
+    Gesture update_gestures(int64_t) override
+    {
+        auto gesture = next_gesture;
+        next_gesture = NO_GESTURE;
+        return gesture;
+    }
+
+    bool both_pressed() override { return buttons_both_pressed; }
+    uint32_t duration(int64_t) override { return button_duration; }
+    uint32_t left_duration(int64_t) override { return left_button_duration; }
+    uint32_t right_duration(int64_t) override { return right_button_duration; }
+};
+
+/*---------------------------------------------------------------------------*/
+
+} // namespace cp_chrono
+
+#endif
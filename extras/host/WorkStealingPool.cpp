@@ -0,0 +1,128 @@
+/*
+    Copyright 2023 Zach Vonler
+
+    This file is part of CircuitPlaygroundChronometer.
+
+    CircuitPlaygroundChronometer is free software: you can redistribute it
+    and/or modify it under the terms of the GNU General Public License as
+    published by the Free Software Foundation, either version 3 of the License,
+    or (at your option) any later version.
+
+    CircuitPlaygroundChronometer is distributed in the hope that it will be
+    useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General
+    Public License for more details.
+
+    You should have received a copy of the GNU General Public License along with
+    CircuitPlaygroundChronometer.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "WorkStealingPool.h"
+
+namespace cp_chrono {
+
+/*---------------------------------------------------------------------------*/
+
+WorkStealingPool::WorkStealingPool(unsigned num_threads)
+{
+    if (!num_threads)
+        num_threads = 1;
+    for (unsigned i = 0; i < num_threads; ++i)
+        _queues.emplace_back(new Queue);
+    for (unsigned i = 0; i < num_threads; ++i)
+        _threads.emplace_back(&WorkStealingPool::run, this, i);
+}
+
+WorkStealingPool::~WorkStealingPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _stopping = true;
+    }
+    _work_available.notify_all();
+    for (auto& thread : _threads)
+        thread.join();
+}
+
+void
+WorkStealingPool::submit(Task task)
+{
+    {
+        // The task is counted under the same lock it is queued under, so a
+        // worker can't take it before it is counted.
+        std::lock_guard<std::mutex> lock(_mutex);
+        auto& queue = *_queues[_next_queue++ % _queues.size()];
+        {
+            std::lock_guard<std::mutex> queue_lock(queue.mutex);
+            queue.tasks.push_back(std::move(task));
+        }
+        ++_queued;
+        ++_unfinished;
+    }
+    _work_available.notify_one();
+}
+
+void
+WorkStealingPool::wait()
+{
+    std::unique_lock<std::mutex> lock(_mutex);
+    _all_done.wait(lock, [this] { return _unfinished == 0; });
+}
+
+bool
+WorkStealingPool::take(unsigned self, Task& task)
+{
+    {
+        auto& own = *_queues[self];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.tasks.empty()) {
+            task = std::move(own.tasks.back());
+            own.tasks.pop_back();
+            return true;
+        }
+    }
+    for (size_t i = 1; i < _queues.size(); ++i) {
+        auto& victim = *_queues[(self + i) % _queues.size()];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.tasks.empty()) {
+            task = std::move(victim.tasks.front());
+            victim.tasks.pop_front();
+            ++_steals;
+            return true;
+        }
+    }
+    return false;
+}
+
+void
+WorkStealingPool::run(unsigned self)
+{
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _work_available.wait(lock, [this] { return _stopping || _queued > 0; });
+            if (_queued == 0)
+                return; // Stopping
+            // Claim one of the queued tasks before taking it, so there are
+            // never fewer tasks in the queues than workers that claimed one.
+            --_queued;
+        }
+
+        // A scan only misses when other claimants empty each queue just
+        // before it is looked at, and a task is left for this worker.
+        Task task;
+        while (!take(self, task))
+            ;
+
+        task();
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            if (--_unfinished == 0)
+                _all_done.notify_all();
+        }
+    }
+}
+
+/*---------------------------------------------------------------------------*/
+
+} // namespace cp_chrono
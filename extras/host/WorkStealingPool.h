@@ -0,0 +1,87 @@
+/*
+    Copyright 2023 Zach Vonler
+
+    This file is part of CircuitPlaygroundChronometer.
+
+    CircuitPlaygroundChronometer is free software: you can redistribute it
+    and/or modify it under the terms of the GNU General Public License as
+    published by the Free Software Foundation, either version 3 of the License,
+    or (at your option) any later version.
+
+    CircuitPlaygroundChronometer is distributed in the hope that it will be
+    useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General
+    Public License for more details.
+
+    You should have received a copy of the GNU General Public License along with
+    CircuitPlaygroundChronometer.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef work_stealing_pool_h
+#define work_stealing_pool_h
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace cp_chrono {
+
+/*---------------------------------------------------------------------------*/
+
+/**
+ * A fixed set of worker threads, each with its own task queue. Workers take
+ * their newest task from their own queue, and when it is empty steal the
+ * oldest task from another worker's queue, so uneven task lengths still keep
+ * every thread busy.
+ */
+class WorkStealingPool
+{
+public:
+    using Task = std::function<void()>;
+
+    explicit WorkStealingPool(unsigned num_threads);
+    ~WorkStealingPool();
+
+    // Queues a task, spreading tasks across the workers' queues in turn.
+    void submit(Task task);
+
+    // Blocks until every submitted task has finished.
+    void wait();
+
+    unsigned num_threads() const { return _threads.size(); }
+
+    // Returns the number of tasks taken from another worker's queue.
+    uint64_t steals() const { return _steals; }
+
+private:
+    struct Queue
+    {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    bool take(unsigned self, Task& task);
+    void run(unsigned self);
+
+    std::vector<std::unique_ptr<Queue>> _queues;
+    std::vector<std::thread> _threads;
+    std::mutex _mutex;
+    std::condition_variable _work_available;
+    std::condition_variable _all_done;
+    size_t _queued = 0;     // Tasks in the queues not yet claimed by a worker
+    size_t _unfinished = 0; // Tasks submitted and not yet finished
+    unsigned _next_queue = 0;
+    bool _stopping = false;
+    std::atomic<uint64_t> _steals{0};
+};
+
+/*---------------------------------------------------------------------------*/
+
+} // namespace cp_chrono
+
+#endif
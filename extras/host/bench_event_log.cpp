@@ -0,0 +1,140 @@
+/*
+    Copyright 2023 Zach Vonler
+
+    This file is part of CircuitPlaygroundChronometer.
+
+    CircuitPlaygroundChronometer is free software: you can redistribute it
+    and/or modify it under the terms of the GNU General Public License as
+    published by the Free Software Foundation, either version 3 of the License,
+    or (at your option) any later version.
+
+    CircuitPlaygroundChronometer is distributed in the hope that it will be
+    useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General
+    Public License for more details.
+
+    You should have received a copy of the GNU General Public License along with
+    CircuitPlaygroundChronometer.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+// Measures the cost of EventLog::log() on the host, for the append path and
+// for the drop path taken when the ring is full. It times batches of calls
+// between drains, as examples/event_log_bench does on the board with SysTick,
+// and reports nanoseconds and, on x86, TSC cycles per call.
+
+#include <chrono>
+#include <cstdio>
+
+#include "EventLog.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define HAVE_TSC 1
+#else
+#define HAVE_TSC 0
+#endif
+
+using namespace cp_chrono;
+
+namespace {
+
+/*---------------------------------------------------------------------------*/
+
+constexpr int BATCH_SIZE = EventLog::CAPACITY;
+constexpr int BATCHES = 200000;
+
+EventLog event_log;
+
+class NullPrint : public Print
+{
+public:
+    using Print::write;
+    size_t write(uint8_t) override { return 1; }
+    int availableForWrite() override { return 1024; }
+};
+
+NullPrint null_print;
+
+void discard_record(Print&, const EventLog::Record&) { }
+
+// Each call goes through a function the compiler can't inline, so calls in a
+// batch can't be merged. The overhead batch calls an empty one.
+__attribute__((noinline)) void
+log_call(int32_t i)
+{
+    event_log.log(1, i, i, 2 * i, 0);
+    asm volatile("" ::: "memory");
+}
+
+__attribute__((noinline)) void
+empty_call(int32_t)
+{
+    asm volatile("" ::: "memory");
+}
+
+uint64_t
+ticks()
+{
+#if HAVE_TSC
+    return __rdtsc();
+#else
+    return 0;
+#endif
+}
+
+struct Timing
+{
+    double ns = 0;
+    double cycles = 0;
+};
+
+// Returns the total time taken by BATCHES batches of BATCH_SIZE calls.
+Timing
+time_batches(bool drain_between, void (*call)(int32_t))
+{
+    using clock = std::chrono::steady_clock;
+    clock::duration elapsed{};
+    uint64_t cycles = 0;
+    for (int b = 0; b < BATCHES; ++b) {
+        if (drain_between)
+            event_log.drain(null_print, discard_record);
+        auto start = clock::now();
+        auto start_ticks = ticks();
+        for (int i = 0; i < BATCH_SIZE; ++i)
+            call(i);
+        cycles += ticks() - start_ticks;
+        elapsed += clock::now() - start;
+    }
+    return { std::chrono::duration<double, std::nano>(elapsed).count(), double(cycles) };
+}
+
+void
+print_timing(const char* name, const Timing& total, const Timing& overhead)
+{
+    constexpr double calls = double(BATCHES) * BATCH_SIZE;
+    printf("%-8s %6.2f ns", name, (total.ns - overhead.ns) / calls);
+    if (HAVE_TSC)
+        printf(" %6.2f cycles", (total.cycles - overhead.cycles) / calls);
+    printf(" per call\n");
+}
+
+/*---------------------------------------------------------------------------*/
+
+} // namespace
+
+int
+main()
+{
+    auto overhead = time_batches(true, empty_call);
+    auto append = time_batches(true, log_call);
+
+    // Fill the ring so every call takes the drop path
+    while (event_log.pending() < EventLog::CAPACITY)
+        event_log.log(1, 0);
+    auto drop = time_batches(false, log_call);
+
+    printf("EventLog::log(), %d batches of %d calls, less the cost of an empty call\n", BATCHES, BATCH_SIZE);
+    print_timing("append", append, overhead);
+    print_timing("drop", drop, overhead);
+    return event_log.dropped() ? 0 : 1;
+}
@@ -0,0 +1,279 @@
+/*
+    Copyright 2023 Zach Vonler
+
+    This file is part of CircuitPlaygroundChronometer.
+
+    CircuitPlaygroundChronometer is free software: you can redistribute it
+    and/or modify it under the terms of the GNU General Public License as
+    published by the Free Software Foundation, either version 3 of the License,
+    or (at your option) any later version.
+
+    CircuitPlaygroundChronometer is distributed in the hope that it will be
+    useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General
+    Public License for more details.
+
+    You should have received a copy of the GNU General Public License along with
+    CircuitPlaygroundChronometer.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+// Runs a fleet of simulated chronometers on the host, each with its own
+// randomized user: posture changes, handling, button gestures, alarms, time
+// zones and clock adjustments. Every frame is checked against invariants of
+// the display and power accounting, and the run reports its throughput in
+// instance-hours simulated per second of wall time.
+//
+// Usage: fleet_sim [--instances N] [--hours H] [--threads T] [--seed S]
+//                  [--frame-ms F]
+//
+// With --frame-ms 0 (the default) each instance waits the interval returned by
+// frame_interval_ms() between updates, as the example sketches do.
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "CPChronometer.h"
+#include "FakeHardware.h"
+#include "TimeZoneRules.h"
+#include "WorkStealingPool.h"
+
+using namespace cp_chrono;
+
+namespace {
+
+/*---------------------------------------------------------------------------*/
+
+struct Options
+{
+    unsigned instances = 256;
+    double hours = 24;
+    unsigned threads = std::thread::hardware_concurrency();
+    uint32_t seed = 1;
+    uint32_t frame_ms = 0;
+};
+
+struct Result
+{
+    uint64_t frames = 0;
+    uint64_t blanked_frames = 0;
+    uint64_t tones = 0;
+    std::string failure;
+};
+
+const TimeZoneRule* const ZONES[] = {
+    &tz::America_New_York,
+    &tz::America_Los_Angeles,
+    &tz::America_St_Johns,
+    &tz::Europe_London,
+    &tz::Asia_Kolkata,
+    &tz::Australia_Sydney,
+    &tz::Pacific_Auckland,
+    &tz::UTC,
+};
+
+const HardwareContext::Gesture GESTURES[] = {
+    HardwareContext::LEFT_CLICKED,
+    HardwareContext::RIGHT_CLICKED,
+    HardwareContext::BOTH_PRESSED,
+    HardwareContext::LEFT_HELD_RIGHT_CLICKED,
+    HardwareContext::RIGHT_HELD_LEFT_CLICKED,
+};
+
+// 2024-01-01T00:00:00Z
+constexpr int64_t START_TM = 1704067200LL * 1000;
+constexpr int64_t MS_PER_HOUR = 3600LL * 1000;
+
+/*---------------------------------------------------------------------------*/
+
+std::string
+failure(int64_t tm, const char* what)
+{
+    char buf[96];
+    snprintf(buf, sizeof(buf), "at %lld ms: %s", (long long)tm, what);
+    return buf;
+}
+
+Result
+simulate(uint32_t seed, const Options& options)
+{
+    Result result;
+    std::mt19937 rng(seed);
+    auto uniform = [&](int64_t lo, int64_t hi) {
+        return std::uniform_int_distribution<int64_t>(lo, hi)(rng);
+    };
+    std::normal_distribution<float> jitter(0, 1.5);
+
+    FakeHardware hardware;
+    CPChronometer cpc(hardware);
+    TimeZone zone(*ZONES[uniform(0, sizeof(ZONES) / sizeof(ZONES[0]) - 1)]);
+
+    int64_t now = START_TM + uniform(0, 365 * 24 * MS_PER_HOUR);
+    int64_t end = now + int64_t(options.hours * MS_PER_HOUR);
+    hardware.switch_on = uniform(0, 3) != 0;
+    cpc.begin();
+    cpc.set_time_zone(&zone);
+    cpc.reset(now);
+    for (int i = uniform(0, 8); i > 0; --i)
+        cpc.alarms().add(uniform(0, 24 * 60 - 1));
+    if (uniform(0, 1))
+        cpc.power_monitor().set_budget_ma(uniform(5, 60));
+
+    int64_t next_event_tm = now;
+    int64_t handheld_until = 0;
+    while (now < end) {
+        if (now >= next_event_tm) {
+            switch (uniform(0, 7)) {
+            case 0: // Set down face up
+                hardware.accel_x = hardware.accel_y = 0;
+                hardware.accel_z = 9.8;
+                break;
+            case 1: // Set down face down
+                hardware.accel_x = hardware.accel_y = 0;
+                hardware.accel_z = -9.8;
+                break;
+            case 2: // Picked up and handled for a while
+                handheld_until = now + uniform(2, 90) * 1000;
+                break;
+            case 3: // Slide switch flipped
+                hardware.switch_on = !hardware.switch_on;
+                hardware.next_gesture = hardware.switch_on
+                    ? HardwareContext::SLIDE_SWITCHED_ON
+                    : HardwareContext::SLIDE_SWITCHED_OFF;
+                break;
+            case 4: // Both buttons held
+                hardware.buttons_both_pressed = true;
+                hardware.button_duration = uniform(0, 8000);
+                hardware.left_button_duration = uniform(0, 8000);
+                hardware.right_button_duration = uniform(0, 8000);
+                break;
+            case 5: // Clock set from a host
+                cpc.increase_clock_offset(uniform(-3600, 3600) * 1000);
+                break;
+            default:
+                hardware.next_gesture = GESTURES[uniform(0, sizeof(GESTURES) / sizeof(GESTURES[0]) - 1)];
+                break;
+            }
+            next_event_tm = now + uniform(1, 600) * 1000;
+        }
+        if (now < handheld_until) {
+            hardware.accel_x = jitter(rng);
+            hardware.accel_y = jitter(rng);
+            hardware.accel_z = 9.8 + jitter(rng);
+        }
+
+        auto shows = hardware.shows;
+        auto was_blanked = cpc.display_blanked();
+        cpc.update(now);
+        hardware.buttons_both_pressed = false;
+        ++result.frames;
+
+        if (cpc.display_blanked()) {
+            ++result.blanked_frames;
+            if (hardware.shows != shows + !was_blanked)
+                result.failure = failure(now, "blanked display was shown");
+            else if (hardware.last_brightness || hardware.indicator)
+                result.failure = failure(now, "blanked display left lit");
+        } else {
+            if (hardware.shows != shows + 1)
+                result.failure = failure(now, "display not shown");
+            else if (hardware.last_brightness > CPChronometer::BRIGHTNESS)
+                result.failure = failure(now, "brightness above limit");
+        }
+        if (!result.failure.empty())
+            return result;
+
+        now += options.frame_ms ? options.frame_ms : cpc.frame_interval_ms();
+    }
+
+    uint64_t accounted = 0;
+    for (int c = 0; c < PowerMonitor::NUM_CATEGORIES; ++c)
+        accounted += cpc.power_monitor().totals(PowerMonitor::Category(c)).frames;
+    if (accounted != result.frames)
+        result.failure = failure(now, "frames missing from power accounting");
+    if (cpc.power_monitor().totals(PowerMonitor::BLANKED).frames != result.blanked_frames)
+        result.failure = failure(now, "blanked frames accounted to another category");
+
+    result.tones = hardware.tones;
+    return result;
+}
+
+bool
+parse_options(int argc, char* argv[], Options& options)
+{
+    for (int i = 1; i < argc; ++i) {
+        const char* value = i + 1 < argc ? argv[i + 1] : nullptr;
+        if (!value)
+            return false;
+        if (!strcmp(argv[i], "--instances"))
+            options.instances = strtoul(value, nullptr, 10);
+        else if (!strcmp(argv[i], "--hours"))
+            options.hours = strtod(value, nullptr);
+        else if (!strcmp(argv[i], "--threads"))
+            options.threads = strtoul(value, nullptr, 10);
+        else if (!strcmp(argv[i], "--seed"))
+            options.seed = strtoul(value, nullptr, 10);
+        else if (!strcmp(argv[i], "--frame-ms"))
+            options.frame_ms = strtoul(value, nullptr, 10);
+        else
+            return false;
+        ++i;
+    }
+    return options.instances > 0 && options.hours > 0;
+}
+
+/*---------------------------------------------------------------------------*/
+
+} // namespace
+
+int
+main(int argc, char* argv[])
+{
+    Options options;
+    if (!parse_options(argc, argv, options)) {
+        fprintf(stderr, "usage: %s [--instances N] [--hours H] [--threads T] [--seed S] [--frame-ms F]\n", argv[0]);
+        return 2;
+    }
+
+    std::vector<Result> results(options.instances);
+    auto start = std::chrono::steady_clock::now();
+    uint64_t steals;
+    unsigned threads;
+    {
+        WorkStealingPool pool(options.threads);
+        for (unsigned i = 0; i < options.instances; ++i)
+            pool.submit([&, i] { results[i] = simulate(options.seed + i, options); });
+        pool.wait();
+        steals = pool.steals();
+        threads = pool.num_threads();
+    }
+    double wall_s = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    uint64_t frames = 0, blanked_frames = 0, tones = 0;
+    int failures = 0;
+    for (unsigned i = 0; i < options.instances; ++i) {
+        frames += results[i].frames;
+        blanked_frames += results[i].blanked_frames;
+        tones += results[i].tones;
+        if (!results[i].failure.empty() && failures++ < 10)
+            fprintf(stderr, "instance %u (seed %u) failed %s\n", i, options.seed + i, results[i].failure.c_str());
+    }
+
+    printf("%u instances x %.1f simulated hours on %u threads\n", options.instances, options.hours, threads);
+    printf("  %llu frames, %.1f%% blanked, %llu tones, %llu steals\n",
+           (unsigned long long)frames, 100.0 * blanked_frames / frames,
+           (unsigned long long)tones, (unsigned long long)steals);
+    printf("  %.2f s wall, %.1f instance-hours/s, %.2fM frames/s\n",
+           wall_s, options.instances * options.hours / wall_s, frames / wall_s / 1e6);
+
+    if (failures) {
+        fprintf(stderr, "%d of %u instances failed\n", failures, options.instances);
+        return 1;
+    }
+    return 0;
+}
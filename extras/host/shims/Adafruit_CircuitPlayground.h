@@ -0,0 +1,83 @@
+/*
+    Copyright 2023 Zach Vonler
+
+    This file is part of CircuitPlaygroundChronometer.
+
+    CircuitPlaygroundChronometer is free software: you can redistribute it
+    and/or modify it under the terms of the GNU General Public License as
+    published by the Free Software Foundation, either version 3 of the License,
+    or (at your option) any later version.
+
+    CircuitPlaygroundChronometer is distributed in the hope that it will be
+    useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General
+    Public License for more details.
+
+    You should have received a copy of the GNU General Public License along with
+    CircuitPlaygroundChronometer.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+// Host stand-in for the parts of the Adafruit Circuit Playground library the
+// board implementation uses. Calls are recorded, and sensor readings are set,
+// by the host tests.
+
+#ifndef host_adafruit_circuit_playground_h
+#define host_adafruit_circuit_playground_h
+
+#include <Arduino.h>
+
+#define CPLAY_NEOPIXELPIN 17
+
+struct sensors_vec_t
+{
+    float x;
+    float y;
+    float z;
+};
+
+struct sensors_event_t
+{
+    sensors_vec_t acceleration;
+};
+
+class Adafruit_CPlay_LIS3DH
+{
+public:
+    bool getEvent(sensors_event_t* event)
+    {
+        *event = next_event;
+        ++reads;
+        return true;
+    }
+
+    // Host only
+    sensors_event_t next_event = { { 0, 0, 9.8 } };
+    uint32_t reads = 0;
+};
+
+class Adafruit_CircuitPlayground
+{
+public:
+    bool begin() { return true; }
+
+    void playTone(uint16_t freq, uint16_t time, bool = true)
+    {
+        tone_frequency = freq;
+        tone_duration = time;
+        ++tones;
+    }
+
+    bool slideSwitch() { return slide_switch; }
+
+    Adafruit_CPlay_LIS3DH lis;
+
+    // Host only
+    bool slide_switch = true;
+    uint16_t tone_frequency = 0;
+    uint16_t tone_duration = 0;
+    uint32_t tones = 0;
+};
+
+inline Adafruit_CircuitPlayground CircuitPlayground;
+
+#endif
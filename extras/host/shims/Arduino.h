@@ -0,0 +1,122 @@
+/*
+    Copyright 2023 Zach Vonler
+
+    This file is part of CircuitPlaygroundChronometer.
+
+    CircuitPlaygroundChronometer is free software: you can redistribute it
+    and/or modify it under the terms of the GNU General Public License as
+    published by the Free Software Foundation, either version 3 of the License,
+    or (at your option) any later version.
+
+    CircuitPlaygroundChronometer is distributed in the hope that it will be
+    useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General
+    Public License for more details.
+
+    You should have received a copy of the GNU General Public License along with
+    CircuitPlaygroundChronometer.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+// Host stand-in for the parts of the Arduino core the library uses.
+
+#ifndef host_arduino_h
+#define host_arduino_h
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+// Arduino's min() and max() accept mixed argument types and yield the type
+// the conditional operator would.
+template <typename A, typename B>
+inline auto min(const A& a, const B& b) -> decltype(a < b ? a : b) { return b < a ? b : a; }
+
+template <typename A, typename B>
+inline auto max(const A& a, const B& b) -> decltype(a < b ? a : b) { return a < b ? b : a; }
+
+#define DEC 10
+#define HEX 16
+
+#define INPUT 0
+#define OUTPUT 1
+#define LOW 0
+#define HIGH 1
+#define LED_BUILTIN 13
+
+// The last mode and level set on each pin, for host tests to inspect
+inline uint8_t host_pin_modes[64];
+inline uint8_t host_pin_levels[64];
+
+inline void pinMode(uint8_t pin, uint8_t mode) { host_pin_modes[pin] = mode; }
+inline void digitalWrite(uint8_t pin, uint8_t level) { host_pin_levels[pin] = level; }
+
+/**
+ * Formats values as text, the same way Arduino's Print class does.
+ */
+class Print
+{
+public:
+    virtual ~Print() { }
+
+    virtual size_t write(uint8_t c) = 0;
+
+    virtual size_t write(const uint8_t* buffer, size_t size)
+    {
+        size_t n = 0;
+        while (size--)
+            n += write(*buffer++);
+        return n;
+    }
+
+    size_t write(const char* str) { return write(reinterpret_cast<const uint8_t*>(str), strlen(str)); }
+
+    virtual int availableForWrite() { return 0; }
+
+    size_t print(const char* str) { return write(str); }
+    size_t print(char c) { return write(uint8_t(c)); }
+    size_t print(int n, int base = DEC) { return print_signed(n, base); }
+    size_t print(long n, int base = DEC) { return print_signed(n, base); }
+    size_t print(long long n, int base = DEC) { return print_signed(n, base); }
+    size_t print(unsigned char n, int base = DEC) { return print_unsigned(n, base); }
+    size_t print(unsigned int n, int base = DEC) { return print_unsigned(n, base); }
+    size_t print(unsigned long n, int base = DEC) { return print_unsigned(n, base); }
+    size_t print(unsigned long long n, int base = DEC) { return print_unsigned(n, base); }
+    size_t print(double n, int digits = 2)
+    {
+        char buffer[32];
+        snprintf(buffer, sizeof(buffer), "%.*f", digits, n);
+        return write(buffer);
+    }
+
+    size_t println() { return write("\r\n"); }
+
+    template <typename T>
+    size_t println(const T& value) { return print(value) + println(); }
+
+    template <typename T>
+    size_t println(const T& value, int base) { return print(value, base) + println(); }
+
+private:
+    size_t print_signed(long long n, int base)
+    {
+        if (n < 0 && base == DEC)
+            return print('-') + print_unsigned(0ULL - (unsigned long long)n, base);
+        return print_unsigned((unsigned long long)n, base);
+    }
+
+    size_t print_unsigned(unsigned long long n, int base)
+    {
+        char buffer[8 * sizeof(n) + 1];
+        char* p = buffer + sizeof(buffer);
+        *--p = 0;
+        do {
+            int digit = n % base;
+            *--p = digit < 10 ? '0' + digit : 'A' + digit - 10;
+            n /= base;
+        } while (n);
+        return write(p);
+    }
+};
+
+#endif
@@ -0,0 +1,71 @@
+/*
+    Copyright 2023 Zach Vonler
+
+    This file is part of CircuitPlaygroundChronometer.
+
+    CircuitPlaygroundChronometer is free software: you can redistribute it
+    and/or modify it under the terms of the GNU General Public License as
+    published by the Free Software Foundation, either version 3 of the License,
+    or (at your option) any later version.
+
+    CircuitPlaygroundChronometer is distributed in the hope that it will be
+    useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General
+    Public License for more details.
+
+    You should have received a copy of the GNU General Public License along with
+    CircuitPlaygroundChronometer.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+// Host stand-in for the CircuitPlaygroundGestures library. The gestures and
+// button durations it reports are set by the host tests.
+
+#ifndef host_circuit_playground_gestures_h
+#define host_circuit_playground_gestures_h
+
+#include <stdint.h>
+
+class CircuitPlaygroundGestures
+{
+public:
+    enum Gesture {
+        NO_GESTURE,
+        SLIDE_SWITCHED_ON,
+        SLIDE_SWITCHED_OFF,
+        LEFT_CLICKED,
+        RIGHT_CLICKED,
+        BOTH_PRESSED,
+        LEFT_HELD_RIGHT_CLICKED,
+        RIGHT_HELD_LEFT_CLICKED,
+    };
+
+    static CircuitPlaygroundGestures& instance()
+    {
+        static CircuitPlaygroundGestures instance;
+        return instance;
+    }
+
+    void begin() { ++begun; }
+
+    Gesture update(int64_t)
+    {
+        auto gesture = next_gesture;
+        next_gesture = NO_GESTURE;
+        return gesture;
+    }
+
+    bool both_pressed() { return buttons_both_pressed; }
+    uint32_t duration(int64_t) { return button_duration; }
+    uint32_t left_duration(int64_t) { return left_button_duration; }
+    uint32_t right_duration(int64_t) { return right_button_duration; }
+
+    // Host only
+    int begun = 0;
+    Gesture next_gesture = NO_GESTURE;
+    bool buttons_both_pressed = false;
+    uint32_t button_duration = 0;
+    uint32_t left_button_duration = 0;
+    uint32_t right_button_duration = 0;
+};
+
+#endif
@@ -0,0 +1,256 @@
+/*
+    Copyright 2023 Zach Vonler
+
+    This file is part of CircuitPlaygroundChronometer.
+
+    CircuitPlaygroundChronometer is free software: you can redistribute it
+    and/or modify it under the terms of the GNU General Public License as
+    published by the Free Software Foundation, either version 3 of the License,
+    or (at your option) any later version.
+
+    CircuitPlaygroundChronometer is distributed in the hope that it will be
+    useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General
+    Public License for more details.
+
+    You should have received a copy of the GNU General Public License along with
+    CircuitPlaygroundChronometer.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+// Host stand-in for the parts of FastLED the library uses. The pixel math
+// follows FastLED's portable C implementations, with FASTLED_SCALE8_FIXED,
+// except for fill_rainbow(), which only approximates FastLED's rainbow hues.
+// Controllers record what they would show instead of driving any pixels.
+
+#ifndef host_fastled_h
+#define host_fastled_h
+
+#include <Arduino.h>
+
+#define FASTLED_SCALE8_FIXED 1
+
+enum LEDColorCorrection : uint32_t {
+    TypicalSMD5050 = 0xFFB0F0,
+    TypicalLEDStrip = 0xFFB0F0,
+    UncorrectedColor = 0xFFFFFF,
+};
+
+inline uint8_t qadd8(uint8_t i, uint8_t j)
+{
+    unsigned t = i + j;
+    return t > 255 ? 255 : t;
+}
+
+inline uint8_t scale8(uint8_t i, uint8_t scale)
+{
+    return (uint16_t(i) * (1 + uint16_t(scale))) >> 8;
+}
+
+inline uint8_t scale8_video(uint8_t i, uint8_t scale)
+{
+    return (uint16_t(i) * scale >> 8) + (i && scale ? 1 : 0);
+}
+
+inline void nscale8x3(uint8_t& r, uint8_t& g, uint8_t& b, uint8_t scale)
+{
+    r = scale8(r, scale);
+    g = scale8(g, scale);
+    b = scale8(b, scale);
+}
+
+inline void nscale8x3_video(uint8_t& r, uint8_t& g, uint8_t& b, uint8_t scale)
+{
+    r = scale8_video(r, scale);
+    g = scale8_video(g, scale);
+    b = scale8_video(b, scale);
+}
+
+inline uint8_t sin8(uint8_t theta)
+{
+    static const uint8_t b_m16_interleave[] = { 0, 49, 49, 41, 90, 27, 117, 10 };
+    uint8_t offset = theta;
+    if (theta & 0x40)
+        offset = 255 - offset;
+    offset &= 0x3F;
+    uint8_t secoffset = offset & 0x0F;
+    if (theta & 0x40)
+        ++secoffset;
+    const uint8_t* p = b_m16_interleave + (offset >> 4) * 2;
+    uint8_t b = p[0];
+    uint8_t m16 = p[1];
+    uint8_t mx = (m16 * secoffset) >> 4;
+    int8_t y = mx + b;
+    if (theta & 0x80)
+        y = -y;
+    y += 128;
+    return y;
+}
+
+struct CRGB
+{
+    union {
+        struct {
+            union { uint8_t r; uint8_t red; };
+            union { uint8_t g; uint8_t green; };
+            union { uint8_t b; uint8_t blue; };
+        };
+        uint8_t raw[3];
+    };
+
+    enum HTMLColorCode : uint32_t {
+        Black = 0x000000,
+        Blue = 0x0000FF,
+        Green = 0x008000,
+        Red = 0xFF0000,
+        White = 0xFFFFFF,
+    };
+
+    CRGB() { }
+
+    constexpr CRGB(uint8_t ir, uint8_t ig, uint8_t ib)
+        : r(ir), g(ig), b(ib)
+    { }
+
+    constexpr CRGB(uint32_t colorcode)
+        : r((colorcode >> 16) & 0xFF), g((colorcode >> 8) & 0xFF), b(colorcode & 0xFF)
+    { }
+
+    constexpr CRGB(HTMLColorCode colorcode)
+        : CRGB(uint32_t(colorcode))
+    { }
+
+    constexpr CRGB(LEDColorCorrection colorcode)
+        : CRGB(uint32_t(colorcode))
+    { }
+
+    CRGB& operator+=(const CRGB& rhs)
+    {
+        r = qadd8(r, rhs.r);
+        g = qadd8(g, rhs.g);
+        b = qadd8(b, rhs.b);
+        return *this;
+    }
+
+    CRGB& nscale8(uint8_t scaledown)
+    {
+        nscale8x3(r, g, b, scaledown);
+        return *this;
+    }
+
+    bool operator==(const CRGB& rhs) const { return r == rhs.r && g == rhs.g && b == rhs.b; }
+    bool operator!=(const CRGB& rhs) const { return !(*this == rhs); }
+};
+
+inline void nscale8(CRGB* leds, uint16_t num_leds, uint8_t scale)
+{
+    for (uint16_t i = 0; i < num_leds; ++i)
+        leds[i].nscale8(scale);
+}
+
+inline void fadeToBlackBy(CRGB* leds, uint16_t num_leds, uint8_t fadeBy)
+{
+    nscale8(leds, num_leds, 255 - fadeBy);
+}
+
+inline void fadeUsingColor(CRGB* leds, uint16_t num_leds, const CRGB& colormask)
+{
+    for (uint16_t i = 0; i < num_leds; ++i) {
+        leds[i].r = scale8(leds[i].r, colormask.r);
+        leds[i].g = scale8(leds[i].g, colormask.g);
+        leds[i].b = scale8(leds[i].b, colormask.b);
+    }
+}
+
+inline void fill_solid(CRGB* leds, int num_leds, const CRGB& color)
+{
+    for (int i = 0; i < num_leds; ++i)
+        leds[i] = color;
+}
+
+inline void fill_rainbow(CRGB* leds, int num_leds, uint8_t initialhue, uint8_t deltahue = 5)
+{
+    uint8_t hue = initialhue;
+    for (int i = 0; i < num_leds; ++i, hue += deltahue) {
+        // Six linear segments around the color wheel
+        uint8_t segment = hue / 43;
+        uint8_t rise = (hue - segment * 43) * 6;
+        uint8_t fall = 255 - rise;
+        switch (segment) {
+        case 0:  leds[i] = CRGB(255, rise, 0); break;
+        case 1:  leds[i] = CRGB(fall, 255, 0); break;
+        case 2:  leds[i] = CRGB(0, 255, rise); break;
+        case 3:  leds[i] = CRGB(0, fall, 255); break;
+        case 4:  leds[i] = CRGB(rise, 0, 255); break;
+        default: leds[i] = CRGB(255, 0, fall); break;
+        }
+    }
+}
+
+enum EOrder {
+    RGB = 0012,
+    GRB = 0102,
+};
+
+template <uint8_t DATA_PIN, EOrder RGB_ORDER = RGB>
+class WS2811 { };
+
+class CLEDController
+{
+public:
+    CLEDController() { }
+
+    CLEDController(CRGB* leds, int num_leds, uint8_t pin)
+        : data_pin(pin), _leds(leds), _num_leds(num_leds)
+    { }
+
+    CLEDController& setCorrection(CRGB correction)
+    {
+        _correction = correction;
+        return *this;
+    }
+
+    CRGB getCorrection() { return _correction; }
+    CRGB* leds() { return _leds; }
+    int size() { return _num_leds; }
+
+    void showLeds(uint8_t brightness = 255)
+    {
+        shown_brightness = brightness;
+        ++shows;
+    }
+
+    // Host only, for tests to inspect
+    uint8_t data_pin = 0;
+    uint8_t shown_brightness = 0;
+    uint32_t shows = 0;
+
+private:
+    CRGB* _leds = nullptr;
+    int _num_leds = 0;
+    CRGB _correction = CRGB(UncorrectedColor);
+};
+
+class CFastLED
+{
+public:
+    constexpr static int MAX_CONTROLLERS = 8;
+
+    template <template <uint8_t, EOrder> class CHIPSET, uint8_t DATA_PIN, EOrder RGB_ORDER>
+    CLEDController& addLeds(CRGB* data, int num_leds)
+    {
+        auto& controller = _controllers[_count++ % MAX_CONTROLLERS];
+        controller = CLEDController(data, num_leds, DATA_PIN);
+        return controller;
+    }
+
+    int count() { return _count; }
+    CLEDController& operator[](int x) { return _controllers[x % MAX_CONTROLLERS]; }
+
+private:
+    CLEDController _controllers[MAX_CONTROLLERS];
+    int _count = 0;
+};
+
+inline CFastLED FastLED;
+
+#endif
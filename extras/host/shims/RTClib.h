@@ -0,0 +1,43 @@
+/*
+    Copyright 2023 Zach Vonler
+
+    This file is part of CircuitPlaygroundChronometer.
+
+    CircuitPlaygroundChronometer is free software: you can redistribute it
+    and/or modify it under the terms of the GNU General Public License as
+    published by the Free Software Foundation, either version 3 of the License,
+    or (at your option) any later version.
+
+    CircuitPlaygroundChronometer is distributed in the hope that it will be
+    useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General
+    Public License for more details.
+
+    You should have received a copy of the GNU General Public License along with
+    CircuitPlaygroundChronometer.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+// Host stand-in for the parts of RTClib the library uses.
+
+#ifndef host_rtclib_h
+#define host_rtclib_h
+
+#include <stdint.h>
+
+class DateTime
+{
+public:
+    DateTime(uint32_t unixtime)
+        : _unixtime(unixtime)
+    { }
+
+    uint8_t hour() const { return _unixtime / 3600 % 24; }
+    uint8_t minute() const { return _unixtime / 60 % 60; }
+    uint8_t second() const { return _unixtime % 60; }
+    uint32_t unixtime() const { return _unixtime; }
+
+private:
+    uint32_t _unixtime;
+};
+
+#endif
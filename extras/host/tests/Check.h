@@ -0,0 +1,70 @@
+/*
+    Copyright 2023 Zach Vonler
+
+    This file is part of CircuitPlaygroundChronometer.
+
+    CircuitPlaygroundChronometer is free software: you can redistribute it
+    and/or modify it under the terms of the GNU General Public License as
+    published by the Free Software Foundation, either version 3 of the License,
+    or (at your option) any later version.
+
+    CircuitPlaygroundChronometer is distributed in the hope that it will be
+    useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General
+    Public License for more details.
+
+    You should have received a copy of the GNU General Public License along with
+    CircuitPlaygroundChronometer.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef check_h
+#define check_h
+
+#include <cstdio>
+
+// Minimal assertions for the host tests. A failed check is reported and
+// counted, and the test carries on so one run shows every failure. main()
+// returns check_result().
+
+namespace cp_chrono {
+namespace check {
+
+inline int failures = 0;
+
+inline bool
+report(bool ok, const char* file, int line, const char* expr, long long a, long long b)
+{
+    if (!ok && ++failures <= 20)
+        fprintf(stderr, "%s:%d: check failed: %s (%lld vs %lld)\n", file, line, expr, a, b);
+    return ok;
+}
+
+template <typename A, typename B, typename Compare>
+bool
+compare(const A& a, const B& b, Compare ok, const char* file, int line, const char* expr)
+{
+    return report(ok(a, b), file, line, expr, (long long)a, (long long)b);
+}
+
+} // namespace check
+
+inline int
+check_result()
+{
+    if (check::failures)
+        fprintf(stderr, "%d checks failed\n", check::failures);
+    return check::failures ? 1 : 0;
+}
+
+} // namespace cp_chrono
+
+#define CHECK(cond) \
+    cp_chrono::check::report(bool(cond), __FILE__, __LINE__, #cond, 1, 0)
+#define CHECK_COMPARE(a, op, b) \
+    cp_chrono::check::compare((a), (b), [](const auto& x, const auto& y) { return x op y; }, \
+                              __FILE__, __LINE__, #a " " #op " " #b)
+#define CHECK_EQ(a, b) CHECK_COMPARE(a, ==, b)
+#define CHECK_LE(a, b) CHECK_COMPARE(a, <=, b)
+#define CHECK_GE(a, b) CHECK_COMPARE(a, >=, b)
+
+#endif
@@ -0,0 +1,167 @@
+/*
+    Copyright 2023 Zach Vonler
+
+    This file is part of CircuitPlaygroundChronometer.
+
+    CircuitPlaygroundChronometer is free software: you can redistribute it
+    and/or modify it under the terms of the GNU General Public License as
+    published by the Free Software Foundation, either version 3 of the License,
+    or (at your option) any later version.
+
+    CircuitPlaygroundChronometer is distributed in the hope that it will be
+    useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General
+    Public License for more details.
+
+    You should have received a copy of the GNU General Public License along with
+    CircuitPlaygroundChronometer.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+// Checks AlarmSchedule against a brute-force count of alarm times crossed,
+// and that CPChronometer fires each alarm once when display time jumps across
+// daylight saving transitions and clock offset changes.
+
+#include <random>
+#include <set>
+
+#include "CPChronometer.h"
+#include "Check.h"
+#include "FakeHardware.h"
+#include "TimeZoneRules.h"
+
+using namespace cp_chrono;
+
+namespace {
+
+/*---------------------------------------------------------------------------*/
+
+constexpr int64_t MS_PER_MINUTE = 60 * 1000;
+constexpr int64_t MS_PER_HOUR = 60 * MS_PER_MINUTE;
+constexpr int64_t MS_PER_DAY = 24 * MS_PER_HOUR;
+
+// Display time moving forward in steps shorter than a minute fires every
+// alarm whose time is crossed, including after adds and removes.
+void
+test_schedule_matches_brute_force()
+{
+    std::mt19937 rng(1);
+    auto uniform = [&](int64_t lo, int64_t hi) {
+        return std::uniform_int_distribution<int64_t>(lo, hi)(rng);
+    };
+
+    AlarmSchedule alarms;
+    std::set<int> minutes;
+    int64_t tm = 1704067200LL * 1000;
+    alarms.reschedule(tm);
+    int fired = 0, expected = 0;
+    for (int step = 0; step < 500000; ++step) {
+        if (uniform(0, 999) == 0) {
+            int minute = uniform(0, AlarmSchedule::MINUTES_PER_DAY - 1);
+            if (minutes.count(minute)) {
+                CHECK(alarms.remove(minute));
+                minutes.erase(minute);
+            } else if (minutes.size() < AlarmSchedule::MAX_ALARMS) {
+                CHECK(alarms.add(minute));
+                minutes.insert(minute);
+            }
+        }
+
+        auto next_tm = tm + uniform(1, MS_PER_MINUTE - 1);
+        // An alarm fires at the start of its minute
+        if (next_tm / MS_PER_MINUTE != tm / MS_PER_MINUTE)
+            expected += minutes.count((next_tm % MS_PER_DAY) / MS_PER_MINUTE);
+        tm = next_tm;
+        fired += alarms.update(tm);
+    }
+    CHECK_EQ(fired, expected);
+    CHECK(fired > 1000);
+}
+
+/**
+ * A chronometer on fake hardware in a time zone, with alarms at the given
+ * local times, updated once a second.
+ */
+struct Bench
+{
+    FakeHardware hardware;
+    CPChronometer cpc{hardware};
+    TimeZone zone{tz::America_New_York};
+    int64_t now;
+
+    Bench(int64_t utc_tm, std::initializer_list<uint16_t> alarm_minutes)
+        : now(utc_tm)
+    {
+        cpc.begin();
+        cpc.set_time_zone(&zone);
+        cpc.reset(now);
+        for (auto minute : alarm_minutes)
+            cpc.alarms().add(minute);
+    }
+
+    // Returns the number of alarms fired while running for duration_ms
+    int run(int64_t duration_ms)
+    {
+        auto tones = hardware.tones;
+        for (auto end = now + duration_ms; now < end; now += 1000) {
+            // Keep the display awake, as if the board were being carried
+            hardware.accel_x = hardware.accel_x ? 0 : 2;
+            cpc.update(now);
+        }
+        return (hardware.tones - tones) / 3;
+    }
+};
+
+// New York falls back from 02:00 EDT to 01:00 EST at 06:00 UTC on
+// 2024-11-03, so 01:00-02:00 local happens twice.
+void
+test_fall_back()
+{
+    constexpr int64_t TRANSITION_TM = 1730613600LL * 1000;
+    Bench bench(TRANSITION_TM - 3 * MS_PER_HOUR, { 1 * 60 + 30, 1 * 60 + 59, 2 * 60 + 30 });
+    CHECK_EQ(bench.run(3 * MS_PER_HOUR), 2);
+    CHECK_EQ(bench.run(2 * MS_PER_HOUR), 1);
+}
+
+// New York springs forward from 02:00 EST to 03:00 EDT at 07:00 UTC on
+// 2024-03-10, so an alarm at 02:30 local is skipped.
+void
+test_spring_forward()
+{
+    constexpr int64_t TRANSITION_TM = 1710054000LL * 1000;
+    Bench bench(TRANSITION_TM - 3 * MS_PER_HOUR, { 1 * 60 + 30, 2 * 60 + 30, 3 * 60 + 30 });
+    CHECK_EQ(bench.run(3 * MS_PER_HOUR), 1);
+    CHECK_EQ(bench.run(2 * MS_PER_HOUR), 1);
+}
+
+// Setting the clock back over an alarm that fired doesn't fire it again, and
+// setting it forward over one skips it.
+void
+test_offset_changes()
+{
+    // 2024-06-01T12:00:00 EDT
+    constexpr int64_t NOON_TM = 1717257600LL * 1000;
+    Bench bench(NOON_TM - 10 * MS_PER_MINUTE, { 12 * 60, 13 * 60 });
+    CHECK_EQ(bench.run(11 * MS_PER_MINUTE), 1);
+    bench.cpc.increase_clock_offset(-10 * MS_PER_MINUTE);
+    CHECK_EQ(bench.run(20 * MS_PER_MINUTE), 0);
+
+    bench.cpc.increase_clock_offset(60 * MS_PER_MINUTE);
+    CHECK_EQ(bench.run(20 * MS_PER_MINUTE), 0);
+
+    // Both fire again the next day
+    CHECK_EQ(bench.run(MS_PER_DAY), 2);
+}
+
+/*---------------------------------------------------------------------------*/
+
+} // namespace
+
+int
+main()
+{
+    test_schedule_matches_brute_force();
+    test_fall_back();
+    test_spring_forward();
+    test_offset_changes();
+    return check_result();
+}
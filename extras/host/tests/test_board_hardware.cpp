@@ -0,0 +1,159 @@
+/*
+    Copyright 2023 Zach Vonler
+
+    This file is part of CircuitPlaygroundChronometer.
+
+    CircuitPlaygroundChronometer is free software: you can redistribute it
+    and/or modify it under the terms of the GNU General Public License as
+    published by the Free Software Foundation, either version 3 of the License,
+    or (at your option) any later version.
+
+    CircuitPlaygroundChronometer is distributed in the hope that it will be
+    useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General
+    Public License for more details.
+
+    You should have received a copy of the GNU General Public License along with
+    CircuitPlaygroundChronometer.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+// Checks CircuitPlaygroundHardware, the board's HardwareContext, against the
+// host stand-ins for the Circuit Playground, CircuitPlaygroundGestures and
+// FastLED libraries: each call must reach the board library call it wraps.
+// Then runs a chronometer on it to check that tones, accelerometer readings
+// and the limited brightness pass through the board implementation.
+
+#include "CircuitPlaygroundHardware.h"
+#include "CPChronometer.h"
+#include "Check.h"
+
+#include <Adafruit_CircuitPlayground.h>
+#include <CircuitPlaygroundGestures.h>
+
+using namespace cp_chrono;
+
+namespace {
+
+/*---------------------------------------------------------------------------*/
+
+using CPG = CircuitPlaygroundGestures;
+
+void
+test_wrapped_calls()
+{
+    CircuitPlaygroundHardware board;
+    CRGB pixels[CPChronometer::NUM_PIXELS];
+    board.begin(pixels, CPChronometer::NUM_PIXELS, TypicalLEDStrip);
+
+    auto& controller = FastLED[FastLED.count() - 1];
+    CHECK(controller.leds() == pixels);
+    CHECK_EQ(controller.size(), CPChronometer::NUM_PIXELS);
+    CHECK_EQ(controller.data_pin, CPLAY_NEOPIXELPIN);
+    CHECK(controller.getCorrection() == CRGB(TypicalLEDStrip));
+    CHECK_EQ(host_pin_modes[LED_BUILTIN], OUTPUT);
+    CHECK_EQ(CPG::instance().begun, 1);
+
+    board.show_leds(5);
+    CHECK_EQ(controller.shows, 1u);
+    CHECK_EQ(controller.shown_brightness, 5);
+
+    board.set_indicator(true);
+    CHECK_EQ(host_pin_levels[LED_BUILTIN], HIGH);
+    board.set_indicator(false);
+    CHECK_EQ(host_pin_levels[LED_BUILTIN], LOW);
+
+    board.play_tone(880, 200);
+    CHECK_EQ(CircuitPlayground.tones, 1u);
+    CHECK_EQ(CircuitPlayground.tone_frequency, 880);
+    CHECK_EQ(CircuitPlayground.tone_duration, 200);
+
+    CircuitPlayground.slide_switch = false;
+    CHECK(!board.slide_switch());
+    CircuitPlayground.slide_switch = true;
+    CHECK(board.slide_switch());
+
+    // Every call reads the accelerometer
+    float x, y, z;
+    auto reads = CircuitPlayground.lis.reads;
+    CircuitPlayground.lis.next_event = { { 1.5, -2.0, 9.5 } };
+    board.read_acceleration(x, y, z);
+    CHECK(x == 1.5f && y == -2.0f && z == 9.5f);
+    CircuitPlayground.lis.next_event = { { 0, 0.5, -9.8 } };
+    board.read_acceleration(x, y, z);
+    CHECK(x == 0.0f && y == 0.5f && z == -9.8f);
+    CHECK_EQ(CircuitPlayground.lis.reads, reads + 2);
+
+    const CPG::Gesture board_gestures[] = {
+        CPG::NO_GESTURE, CPG::SLIDE_SWITCHED_ON, CPG::SLIDE_SWITCHED_OFF,
+        CPG::LEFT_CLICKED, CPG::RIGHT_CLICKED, CPG::BOTH_PRESSED,
+        CPG::LEFT_HELD_RIGHT_CLICKED, CPG::RIGHT_HELD_LEFT_CLICKED,
+    };
+    const HardwareContext::Gesture gestures[] = {
+        HardwareContext::NO_GESTURE, HardwareContext::SLIDE_SWITCHED_ON, HardwareContext::SLIDE_SWITCHED_OFF,
+        HardwareContext::LEFT_CLICKED, HardwareContext::RIGHT_CLICKED, HardwareContext::BOTH_PRESSED,
+        HardwareContext::LEFT_HELD_RIGHT_CLICKED, HardwareContext::RIGHT_HELD_LEFT_CLICKED,
+    };
+    for (int i = 0; i < 8; ++i) {
+        CPG::instance().next_gesture = board_gestures[i];
+        CHECK_EQ(board.update_gestures(0), gestures[i]);
+    }
+
+    CPG::instance().buttons_both_pressed = true;
+    CPG::instance().button_duration = 1200;
+    CPG::instance().left_button_duration = 1300;
+    CPG::instance().right_button_duration = 1100;
+    CHECK(board.both_pressed());
+    CHECK_EQ(board.duration(0), 1200u);
+    CHECK_EQ(board.left_duration(0), 1300u);
+    CHECK_EQ(board.right_duration(0), 1100u);
+    CPG::instance().buttons_both_pressed = false;
+}
+
+// A countdown run on the board implementation: its tones reach the speaker,
+// turning the board over blanks the display, and a current budget limits the
+// brightness the NeoPixels are shown at.
+void
+test_chronometer_on_board()
+{
+    CircuitPlaygroundHardware board;
+    CPChronometer cpc(board);
+    CircuitPlayground.slide_switch = false;
+    CircuitPlayground.lis.next_event = { { 0, 0, 9.8 } };
+    cpc.begin();
+    auto& controller = FastLED[FastLED.count() - 1];
+
+    int64_t now = 1000;
+    cpc.reset(now);
+    for (int i = 0; i < CPChronometer::NUM_PIXELS; ++i) {
+        CPG::instance().next_gesture = CPG::RIGHT_CLICKED;
+        cpc.update(now);
+        now += 300;
+    }
+    cpc.update(now);
+    CHECK_EQ(controller.shown_brightness, CPChronometer::BRIGHTNESS);
+
+    cpc.power_monitor().set_budget_ma(7);
+    cpc.update(now += CPChronometer::FRAME_INTERVAL_MS);
+    CHECK(controller.shown_brightness < CPChronometer::BRIGHTNESS);
+
+    CircuitPlayground.lis.next_event = { { 0, 0, -9.8 } };
+    auto tones = CircuitPlayground.tones;
+    auto end = now + int64_t(CPChronometer::MAX_TIMEOUT);
+    while (now < end)
+        cpc.update(now += cpc.frame_interval_ms());
+    CHECK(cpc.display_blanked());
+    CHECK_EQ(controller.shown_brightness, 0);
+    CHECK_EQ(CircuitPlayground.tones, tones + 3);
+}
+
+/*---------------------------------------------------------------------------*/
+
+} // namespace
+
+int
+main()
+{
+    test_wrapped_calls();
+    test_chronometer_on_board();
+    return check_result();
+}
@@ -0,0 +1,147 @@
+/*
+    Copyright 2023 Zach Vonler
+
+    This file is part of CircuitPlaygroundChronometer.
+
+    CircuitPlaygroundChronometer is free software: you can redistribute it
+    and/or modify it under the terms of the GNU General Public License as
+    published by the Free Software Foundation, either version 3 of the License,
+    or (at your option) any later version.
+
+    CircuitPlaygroundChronometer is distributed in the hope that it will be
+    useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General
+    Public License for more details.
+
+    You should have received a copy of the GNU General Public License along with
+    CircuitPlaygroundChronometer.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+// Checks that EventLog only writes whole lines, reports drops once, and
+// truncates long lines.
+
+#include <string>
+
+#include "Check.h"
+#include "EventLog.h"
+
+using namespace cp_chrono;
+
+namespace {
+
+/*---------------------------------------------------------------------------*/
+
+// Collects output, with a settable amount of write space.
+class CapturePrint : public Print
+{
+public:
+    using Print::write;
+
+    size_t write(uint8_t c) override
+    {
+        if (space == 0)
+            ++overruns;
+        else
+            --space;
+        output += char(c);
+        return 1;
+    }
+
+    int availableForWrite() override { return space; }
+
+    std::string output;
+    int space = 0;
+    int overruns = 0;
+};
+
+void
+format_record(Print& out, const EventLog::Record& record)
+{
+    out.print("e");
+    out.print(record.event);
+    out.print(" ");
+    out.print(record.args[0]);
+    out.println();
+}
+
+void
+format_long(Print& out, const EventLog::Record&)
+{
+    for (int i = 0; i < 100; ++i)
+        out.print('x');
+    out.println();
+}
+
+void
+test_whole_lines()
+{
+    EventLog log;
+    CapturePrint out;
+    log.log(1, 0, 10);
+    log.log(2, 0, -20);
+    CHECK_EQ(log.pending(), 2);
+
+    // "e1 10\r\n" is 7 bytes
+    out.space = 6;
+    CHECK_EQ(log.drain(out, format_record), 0);
+    CHECK(out.output.empty());
+
+    out.space = 7;
+    CHECK_EQ(log.drain(out, format_record), 1);
+    CHECK(out.output == "e1 10\r\n");
+
+    // The second line was formatted by the last call, and is written as is
+    out.space = 63;
+    CHECK_EQ(log.drain(out, format_record), 1);
+    CHECK(out.output == "e1 10\r\ne2 -20\r\n");
+    CHECK_EQ(log.pending(), 0);
+    CHECK_EQ(log.drain(out, format_record), 0);
+    CHECK_EQ(out.overruns, 0);
+}
+
+void
+test_dropped()
+{
+    EventLog log;
+    CapturePrint out;
+    for (int i = 0; i < EventLog::CAPACITY + 8; ++i)
+        log.log(1, i, i);
+    CHECK_EQ(log.pending(), EventLog::CAPACITY);
+    CHECK_EQ(log.dropped(), 8u);
+
+    out.space = 10000;
+    CHECK_EQ(log.drain(out, format_record), EventLog::CAPACITY + 1);
+    CHECK(out.output.rfind("(dropped 8 log records)\r\ne1 0\r\ne1 1\r\n", 0) == 0);
+
+    // Only new drops are reported
+    log.log(1, 0, 0);
+    out.output.clear();
+    CHECK_EQ(log.drain(out, format_record), 1);
+    CHECK(out.output == "e1 0\r\n");
+    CHECK_EQ(out.overruns, 0);
+}
+
+void
+test_truncated()
+{
+    EventLog log;
+    CapturePrint out;
+    log.log(1, 0);
+    out.space = 63;
+    CHECK_EQ(log.drain(out, format_long), 1);
+    CHECK_EQ(out.output.size(), EventLog::MAX_LINE);
+    CHECK_EQ(out.overruns, 0);
+}
+
+/*---------------------------------------------------------------------------*/
+
+} // namespace
+
+int
+main()
+{
+    test_whole_lines();
+    test_dropped();
+    test_truncated();
+    return check_result();
+}
@@ -0,0 +1,207 @@
+/*
+    Copyright 2023 Zach Vonler
+
+    This file is part of CircuitPlaygroundChronometer.
+
+    CircuitPlaygroundChronometer is free software: you can redistribute it
+    and/or modify it under the terms of the GNU General Public License as
+    published by the Free Software Foundation, either version 3 of the License,
+    or (at your option) any later version.
+
+    CircuitPlaygroundChronometer is distributed in the hope that it will be
+    useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General
+    Public License for more details.
+
+    You should have received a copy of the GNU General Public License along with
+    CircuitPlaygroundChronometer.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+// Drives CPChronometer with scripted accelerometer readings and button
+// gestures through FakeHardware, checking when the display blanks and wakes.
+
+#include <random>
+
+#include "CPChronometer.h"
+#include "Check.h"
+#include "FakeHardware.h"
+
+using namespace cp_chrono;
+
+namespace {
+
+/*---------------------------------------------------------------------------*/
+
+constexpr int64_t START_TM = 1704067200LL * 1000;
+
+/**
+ * A chronometer on fake hardware, updated at the interval it asks for.
+ */
+struct Bench
+{
+    FakeHardware hardware;
+    CPChronometer cpc{hardware};
+    int64_t now = START_TM;
+    int64_t elapsed_ms = 0;
+    int64_t blanked_ms = 0;
+    uint64_t frames = 0;
+    uint64_t rendered_frames = 0;
+    std::mt19937 rng{1};
+    bool handheld = false;
+
+    explicit Bench(bool switch_on = true)
+    {
+        hardware.switch_on = switch_on;
+        cpc.begin();
+        cpc.reset(now);
+    }
+
+    void place(float x, float y, float z)
+    {
+        handheld = false;
+        hardware.accel_x = x;
+        hardware.accel_y = y;
+        hardware.accel_z = z;
+    }
+
+    void face_up() { place(0, 0, 9.8); }
+    void face_down() { place(0, 0, -9.8); }
+    void pick_up() { handheld = true; }
+
+    // Runs a single update and returns true if the display is blanked after it
+    bool frame()
+    {
+        if (handheld) {
+            std::normal_distribution<float> jitter(0, 1.5);
+            hardware.accel_x = jitter(rng);
+            hardware.accel_y = jitter(rng);
+            hardware.accel_z = 9.8 + jitter(rng);
+        }
+        cpc.update(now);
+        ++frames;
+        bool blanked = cpc.display_blanked();
+        auto interval = cpc.frame_interval_ms();
+        if (blanked)
+            blanked_ms += interval;
+        else
+            ++rendered_frames;
+        elapsed_ms += interval;
+        now += interval;
+        return blanked;
+    }
+
+    // Runs frames for duration_ms and returns the time from the start of the
+    // run to the first blanked frame, or -1 if none was blanked.
+    int64_t run(int64_t duration_ms)
+    {
+        int64_t first_blanked = -1;
+        for (auto start = now; now - start < duration_ms; ) {
+            auto tm = now;
+            if (frame() && first_blanked < 0)
+                first_blanked = tm - start;
+        }
+        return first_blanked;
+    }
+};
+
+/*---------------------------------------------------------------------------*/
+
+// Ten minutes face down on a desk, picked up and handled for half a minute,
+// then left face up on the desk for five minutes.
+void
+test_pickup_script()
+{
+    Bench bench;
+
+    bench.face_down();
+    auto blanked_after = bench.run(10 * 60 * 1000);
+    CHECK_GE(blanked_after, MotionMonitor::FACE_DOWN_DELAY);
+    CHECK_LE(blanked_after, MotionMonitor::FACE_DOWN_DELAY + CPChronometer::FRAME_INTERVAL_MS);
+    CHECK(bench.cpc.display_blanked());
+
+    // The first frame after pickup is shown
+    bench.pick_up();
+    CHECK(!bench.frame());
+    CHECK_EQ(bench.hardware.last_brightness, CPChronometer::BRIGHTNESS);
+    CHECK_EQ(bench.run(30 * 1000), -1);
+
+    bench.face_up();
+    blanked_after = bench.run(5 * 60 * 1000);
+    CHECK_GE(blanked_after, MotionMonitor::STILL_DELAY - CPChronometer::FRAME_INTERVAL_MS);
+    CHECK_LE(blanked_after, MotionMonitor::STILL_DELAY + CPChronometer::FRAME_INTERVAL_MS);
+    CHECK(bench.cpc.display_blanked());
+
+    // Awake for about 2 s + 30 s + 2 min of the 15.5 min script
+    auto full_rate_frames = bench.elapsed_ms / CPChronometer::FRAME_INTERVAL_MS;
+    auto blanked = double(bench.blanked_ms) / bench.elapsed_ms;
+    auto shows_saved = 1 - double(bench.rendered_frames) / full_rate_frames;
+    auto updates_saved = 1 - double(bench.frames) / full_rate_frames;
+    printf("pickup script: %.1f%% of time blanked, %.1f%% of shows and %.1f%% of updates saved\n",
+           100 * blanked, 100 * shows_saved, 100 * updates_saved);
+    CHECK(blanked >= 0.8);
+    CHECK(shows_saved >= 0.7);
+    CHECK(updates_saved >= 0.5);
+}
+
+// A countdown keeps a still board lit, and still sounds when it runs out
+// with the board face down.
+void
+test_countdown_while_blanked()
+{
+    Bench bench(false);
+
+    for (int i = 0; i < 3; ++i) {
+        bench.hardware.next_gesture = HardwareContext::RIGHT_CLICKED;
+        bench.run(300);
+    }
+    CHECK_EQ(bench.run(MotionMonitor::STILL_DELAY + 10 * 1000), -1);
+
+    bench.face_down();
+    bench.run(MotionMonitor::FACE_DOWN_DELAY + 1000);
+    CHECK(bench.cpc.display_blanked());
+    CHECK_EQ(bench.hardware.tones, 0u);
+    bench.run(60 * 1000);
+    CHECK(bench.cpc.display_blanked());
+    CHECK_EQ(bench.hardware.tones, 3u);
+}
+
+// Any gesture wakes a blanked display, but a button gesture only takes effect
+// once the display is showing.
+void
+test_gesture_wakes()
+{
+    Bench bench;
+
+    CHECK_GE(bench.run(MotionMonitor::STILL_DELAY + 1000), 0);
+    CHECK(bench.cpc.display_blanked());
+
+    auto offset = bench.cpc.clock_offset();
+    bench.hardware.next_gesture = HardwareContext::LEFT_HELD_RIGHT_CLICKED;
+    CHECK(!bench.frame());
+    CHECK_EQ(bench.cpc.clock_offset(), offset);
+
+    bench.run(300);
+    bench.hardware.next_gesture = HardwareContext::LEFT_HELD_RIGHT_CLICKED;
+    CHECK(!bench.frame());
+    CHECK_EQ(bench.cpc.clock_offset(), offset + 60 * 1000);
+
+    // Sliding the switch wakes the display and changes mode
+    CHECK_GE(bench.run(MotionMonitor::STILL_DELAY + 1000), 0);
+    bench.hardware.switch_on = false;
+    bench.hardware.next_gesture = HardwareContext::SLIDE_SWITCHED_OFF;
+    CHECK(!bench.frame());
+    CHECK(bench.cpc.power_monitor().totals(PowerMonitor::IDLE).frames == 1);
+}
+
+/*---------------------------------------------------------------------------*/
+
+} // namespace
+
+int
+main()
+{
+    test_pickup_script();
+    test_countdown_while_blanked();
+    test_gesture_wakes();
+    return check_result();
+}
@@ -0,0 +1,142 @@
+/*
+    Copyright 2023 Zach Vonler
+
+    This file is part of CircuitPlaygroundChronometer.
+
+    CircuitPlaygroundChronometer is free software: you can redistribute it
+    and/or modify it under the terms of the GNU General Public License as
+    published by the Free Software Foundation, either version 3 of the License,
+    or (at your option) any later version.
+
+    CircuitPlaygroundChronometer is distributed in the hope that it will be
+    useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General
+    Public License for more details.
+
+    You should have received a copy of the GNU General Public License along with
+    CircuitPlaygroundChronometer.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+// Checks that the pixel kernels match FastLED bit for bit, for buffers at each
+// offset from word alignment and every length up to 63 pixels, and that they
+// leave the bytes around the buffer alone. Built once with the word-parallel
+// kernels and once with CP_CHRONO_SCALAR_PIXEL_KERNELS.
+
+#include <random>
+
+#include "Check.h"
+#include "PixelKernels.h"
+
+#if !defined(CP_CHRONO_SCALAR_PIXEL_KERNELS) && !defined(CP_CHRONO_SWAR_PIXEL_KERNELS)
+#error "The word-parallel kernels should be enabled with the host FastLED"
+#endif
+
+using namespace cp_chrono;
+
+namespace {
+
+/*---------------------------------------------------------------------------*/
+
+constexpr int MAX_PIXELS = 63;
+constexpr int GUARD = 8;
+constexpr int BUFFER_SIZE = GUARD + 4 + 3 * MAX_PIXELS + GUARD;
+
+struct Buffers
+{
+    alignas(4) uint8_t kernel[BUFFER_SIZE];
+    alignas(4) uint8_t fastled[BUFFER_SIZE];
+
+    void randomize(std::mt19937& rng)
+    {
+        for (int i = 0; i < BUFFER_SIZE; ++i)
+            kernel[i] = fastled[i] = rng();
+    }
+
+    // Returns the pixels at offset bytes past a word boundary in each buffer
+    CRGB* kernel_pixels(int offset) { return reinterpret_cast<CRGB*>(kernel + GUARD + offset); }
+    CRGB* fastled_pixels(int offset) { return reinterpret_cast<CRGB*>(fastled + GUARD + offset); }
+
+    bool match() const { return memcmp(kernel, fastled, BUFFER_SIZE) == 0; }
+};
+
+uint8_t
+random_amount(std::mt19937& rng)
+{
+    // Include the amounts at either end of the scale, where rounding differs
+    static const uint8_t edges[] = { 0, 1, 127, 128, 254, 255 };
+    auto r = rng();
+    return r % 4 == 0 ? edges[(r >> 2) % sizeof(edges)] : uint8_t(r >> 8);
+}
+
+CRGB
+random_color(std::mt19937& rng)
+{
+    auto r = rng();
+    // Solid gray fills take their own path
+    if (r % 4 == 0)
+        return CRGB(r >> 8, r >> 8, r >> 8);
+    return CRGB(r >> 8, r >> 16, r >> 24);
+}
+
+// Runs kernel(rng, pixels, expected, n), which should apply a pixel kernel to
+// pixels and the equivalent FastLED code to expected.
+template <typename Kernel>
+void
+check_kernel(const char* name, std::mt19937& rng, Kernel kernel)
+{
+    Buffers buffers;
+    int mismatches = 0;
+    for (int offset = 0; offset < 4; ++offset) {
+        for (int n = 0; n <= MAX_PIXELS; ++n) {
+            for (int trial = 0; trial < 20; ++trial) {
+                buffers.randomize(rng);
+                kernel(rng, buffers.kernel_pixels(offset), buffers.fastled_pixels(offset), n);
+                if (!CHECK(buffers.match()))
+                    fprintf(stderr, "  %s: offset %d, %d pixels\n", name, offset, n);
+                mismatches += !buffers.match();
+            }
+        }
+    }
+    printf("%-18s %s\n", name, mismatches ? "FAILED" : "ok");
+}
+
+/*---------------------------------------------------------------------------*/
+
+} // namespace
+
+int
+main()
+{
+    std::mt19937 rng(1);
+
+    check_kernel("fade_to_black_by", rng,
+        [](std::mt19937& rng, CRGB* pixels, CRGB* expected, int n) {
+            auto amount = random_amount(rng);
+            pixel_kernels::fade_to_black_by(pixels, n, amount);
+            fadeToBlackBy(expected, n, amount);
+        });
+
+    check_kernel("scale", rng,
+        [](std::mt19937& rng, CRGB* pixels, CRGB* expected, int n) {
+            auto amount = random_amount(rng);
+            pixel_kernels::scale(pixels, n, amount);
+            nscale8(expected, n, amount);
+        });
+
+    check_kernel("fill_solid", rng,
+        [](std::mt19937& rng, CRGB* pixels, CRGB* expected, int n) {
+            auto color = random_color(rng);
+            pixel_kernels::fill_solid(pixels, n, color);
+            fill_solid(expected, n, color);
+        });
+
+    check_kernel("add", rng,
+        [](std::mt19937& rng, CRGB* pixels, CRGB* expected, int n) {
+            auto color = random_color(rng);
+            pixel_kernels::add(pixels, n, color);
+            for (int i = 0; i < n; ++i)
+                expected[i] += color;
+        });
+
+    return check_result();
+}
@@ -0,0 +1,161 @@
+/*
+    Copyright 2023 Zach Vonler
+
+    This file is part of CircuitPlaygroundChronometer.
+
+    CircuitPlaygroundChronometer is free software: you can redistribute it
+    and/or modify it under the terms of the GNU General Public License as
+    published by the Free Software Foundation, either version 3 of the License,
+    or (at your option) any later version.
+
+    CircuitPlaygroundChronometer is distributed in the hope that it will be
+    useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General
+    Public License for more details.
+
+    You should have received a copy of the GNU General Public License along with
+    CircuitPlaygroundChronometer.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+// Drives PowerMonitor with known pixels, brightness and frame spacing, and
+// checks the current estimates, per-category totals and limited brightness.
+
+#include "CPChronometer.h"
+#include "Check.h"
+#include "FakeHardware.h"
+
+using namespace cp_chrono;
+
+namespace {
+
+/*---------------------------------------------------------------------------*/
+
+constexpr int NUM_PIXELS = 10;
+
+void
+fill(CRGB* pixels, CRGB color)
+{
+    for (int i = 0; i < NUM_PIXELS; ++i)
+        pixels[i] = color;
+}
+
+void
+test_estimates()
+{
+    CRGB pixels[NUM_PIXELS];
+    PowerMonitor uncorrected;
+
+    fill(pixels, CRGB::Black);
+    CHECK_EQ(uncorrected.estimate_ua(pixels, NUM_PIXELS, 255), 10 * PowerMonitor::PIXEL_QUIESCENT_UA);
+
+    // One full channel per pixel
+    fill(pixels, CRGB::Red);
+    CHECK_EQ(uncorrected.estimate_ua(pixels, NUM_PIXELS, 255), 206000u);
+    CHECK_EQ(uncorrected.estimate_ua(pixels, NUM_PIXELS, 119), 99333u);
+    CHECK_EQ(uncorrected.estimate_ua(pixels, NUM_PIXELS, 0), 6000u);
+
+    // Color correction dims green and blue before they reach the pixels
+    fill(pixels, CRGB::White);
+    CHECK_EQ(PowerMonitor(TypicalLEDStrip).estimate_ua(pixels, NUM_PIXELS, 255), 532274u);
+}
+
+void
+test_accounting()
+{
+    CRGB red[NUM_PIXELS], black[NUM_PIXELS];
+    fill(red, CRGB::Red);
+    fill(black, CRGB::Black);
+
+    PowerMonitor monitor;
+    monitor.set_budget_ma(100);
+    auto& clock = monitor.totals(PowerMonitor::CLOCK);
+    auto& idle = monitor.totals(PowerMonitor::IDLE);
+    auto& blanked = monitor.totals(PowerMonitor::BLANKED);
+
+    // 206 mA at full brightness is limited to the 94 mA left after the
+    // quiescent current: 255 * 94 / 200 = 119
+    CHECK_EQ(monitor.account(PowerMonitor::CLOCK, red, NUM_PIXELS, 255, 1000), 119);
+    CHECK_EQ(clock.charge, 0u);
+    CHECK_EQ(monitor.account(PowerMonitor::CLOCK, red, NUM_PIXELS, 255, 1010), 119);
+    CHECK_EQ(clock.charge, 99333u * 10);
+    CHECK_EQ(clock.duration, 10u);
+
+    // A frame at the same time adds nothing
+    CHECK_EQ(monitor.account(PowerMonitor::CLOCK, red, NUM_PIXELS, 255, 1010), 119);
+    CHECK_EQ(clock.duration, 10u);
+
+    // The time up to the next frame is charged to the previous frame's
+    // category
+    CHECK_EQ(monitor.account(PowerMonitor::IDLE, black, NUM_PIXELS, 255, 1020), 255);
+    CHECK_EQ(clock.charge, 99333u * 20);
+    CHECK_EQ(clock.duration, 20u);
+    CHECK_EQ(clock.average_ua(), 99333u);
+    CHECK_EQ(idle.charge, 0u);
+
+    // A long gap is only charged for its first second
+    monitor.account(PowerMonitor::BLANKED, black, NUM_PIXELS, 0, 4020);
+    CHECK_EQ(idle.charge, 6000u * 1000);
+    CHECK_EQ(idle.duration, 1000u);
+    monitor.account(PowerMonitor::BLANKED, black, NUM_PIXELS, 0, 4050);
+    CHECK_EQ(blanked.charge, 6000u * 30);
+    CHECK_EQ(blanked.duration, 30u);
+
+    // Without a budget nothing is limited
+    monitor.set_budget_ma(0);
+    CHECK_EQ(monitor.account(PowerMonitor::CLOCK, red, NUM_PIXELS, 255, 4060), 255);
+    CHECK_EQ(blanked.charge, 6000u * 40);
+
+    CHECK_EQ(clock.frames, 4u);
+    CHECK_EQ(clock.limited_frames, 3u);
+    CHECK_EQ(idle.frames, 1u);
+    CHECK_EQ(idle.limited_frames, 0u);
+    CHECK_EQ(blanked.frames, 2u);
+    CHECK_EQ(blanked.limited_frames, 0u);
+    CHECK_EQ(monitor.totals(PowerMonitor::COUNT_UP).frames, 0u);
+    CHECK_EQ(monitor.totals(PowerMonitor::COUNT_DOWN).frames, 0u);
+}
+
+// The limited brightness is what the chronometer shows the NeoPixels at
+void
+test_chronometer_limit()
+{
+    FakeHardware hardware;
+    hardware.switch_on = false;
+    CPChronometer cpc(hardware);
+    int64_t now = 1000;
+    cpc.begin();
+    cpc.reset(now);
+
+    // A ten minute countdown lights every pixel
+    for (int i = 0; i < CPChronometer::NUM_PIXELS; ++i) {
+        hardware.next_gesture = HardwareContext::RIGHT_CLICKED;
+        cpc.update(now);
+        now += 300;
+    }
+    cpc.update(now);
+    CHECK_EQ(hardware.last_brightness, CPChronometer::BRIGHTNESS);
+    auto ua = cpc.power_monitor().estimate_ua(hardware.pixels, hardware.num_pixels, CPChronometer::BRIGHTNESS);
+
+    // Leave a third of the lit current in the budget
+    uint16_t budget_ma = (6000 + (ua - 6000) / 3) / 1000;
+    cpc.power_monitor().set_budget_ma(budget_ma);
+    cpc.update(now += CPChronometer::FRAME_INTERVAL_MS);
+    CHECK(hardware.last_brightness < CPChronometer::BRIGHTNESS);
+    CHECK(hardware.last_brightness > 0);
+    CHECK_LE(cpc.power_monitor().estimate_ua(hardware.pixels, hardware.num_pixels, hardware.last_brightness),
+             budget_ma * 1000u);
+    CHECK_EQ(cpc.power_monitor().totals(PowerMonitor::COUNT_DOWN).limited_frames, 1u);
+}
+
+/*---------------------------------------------------------------------------*/
+
+} // namespace
+
+int
+main()
+{
+    test_estimates();
+    test_accounting();
+    test_chronometer_limit();
+    return check_result();
+}
@@ -0,0 +1,140 @@
+/*
+    Copyright 2023 Zach Vonler
+
+    This file is part of CircuitPlaygroundChronometer.
+
+    CircuitPlaygroundChronometer is free software: you can redistribute it
+    and/or modify it under the terms of the GNU General Public License as
+    published by the Free Software Foundation, either version 3 of the License,
+    or (at your option) any later version.
+
+    CircuitPlaygroundChronometer is distributed in the hope that it will be
+    useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General
+    Public License for more details.
+
+    You should have received a copy of the GNU General Public License along with
+    CircuitPlaygroundChronometer.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+// Checks TimeZone against the host C library's conversions, which read the
+// same tz database that extras/tzcompile.py compiled the rules from. Every
+// generated zone is stepped forward and backward through 2020-2039, and
+// checked on both sides of each transition and at random instants.
+
+#include <cstdlib>
+#include <ctime>
+#include <random>
+#include <vector>
+
+#include "Check.h"
+#include "TimeZoneRules.h"
+
+using namespace cp_chrono;
+
+namespace {
+
+/*---------------------------------------------------------------------------*/
+
+constexpr int64_t FIRST_S = 1577836800; // 2020-01-01T00:00:00Z
+constexpr int64_t LAST_S = 2208988800;  // 2040-01-01T00:00:00Z
+constexpr int64_t STEP_S = 15 * 60;
+constexpr int YEARS = 20;
+
+// Returns the reference offset in ms at utc_s for the zone selected by TZ.
+int32_t
+reference_offset(int64_t utc_s)
+{
+    time_t t = utc_s;
+    struct tm local;
+    localtime_r(&t, &local);
+    return local.tm_gmtoff * 1000;
+}
+
+// Returns the first second in (after_s, before_s] with the offset at before_s.
+int64_t
+find_transition(int64_t after_s, int64_t before_s)
+{
+    auto offset = reference_offset(before_s);
+    while (before_s - after_s > 1) {
+        auto mid = after_s + (before_s - after_s) / 2;
+        if (reference_offset(mid) == offset)
+            before_s = mid;
+        else
+            after_s = mid;
+    }
+    return before_s;
+}
+
+void
+check_zone(const TimeZoneRule& rule, std::mt19937& rng)
+{
+    bool has_dst = rule.std_offset != rule.dst_offset;
+
+    // Forward, counting how often the cache is recomputed
+    std::vector<int64_t> transitions;
+    TimeZone forward(rule);
+    int recomputes = 0;
+    int64_t cached_next = 0;
+    int32_t previous = reference_offset(FIRST_S);
+    for (int64_t s = FIRST_S; s < LAST_S; s += STEP_S) {
+        auto expected = reference_offset(s);
+        CHECK_EQ(forward.offset(s * 1000), expected);
+        if (forward.next_transition_tm() != cached_next) {
+            cached_next = forward.next_transition_tm();
+            ++recomputes;
+        }
+        if (expected != previous)
+            transitions.push_back(find_transition(s - STEP_S, s));
+        previous = expected;
+    }
+    CHECK_EQ(transitions.size(), has_dst ? 2 * YEARS : 0);
+    CHECK_LE(recomputes, int(transitions.size()) + 1);
+
+    // Backward
+    TimeZone backward(rule);
+    for (int64_t s = LAST_S - 1; s >= FIRST_S; s -= STEP_S)
+        CHECK_EQ(backward.offset(s * 1000), reference_offset(s));
+
+    // The last millisecond before each transition and the first one after,
+    // approached from either side with the cache holding the other side
+    TimeZone zone(rule);
+    for (auto t : transitions) {
+        auto before = reference_offset(t - 1);
+        auto after = reference_offset(t);
+        CHECK(before != after);
+        CHECK_EQ(zone.offset(t * 1000 - 1), before);
+        CHECK_EQ(zone.offset(t * 1000), after);
+        CHECK_EQ(zone.offset(t * 1000 - 1), before);
+        CHECK_EQ(zone.offset(t * 1000 + STEP_S * 1000), after);
+        CHECK_EQ(zone.offset(t * 1000 - 1), before);
+        CHECK_EQ(zone.offset(t * 1000 - STEP_S * 1000), before);
+        CHECK_EQ(zone.offset(t * 1000), after);
+    }
+
+    // Random jumps, including across years
+    std::uniform_int_distribution<int64_t> instant(FIRST_S * 1000, LAST_S * 1000 - 1);
+    TimeZone jumping(rule);
+    for (int i = 0; i < 20000; ++i) {
+        auto tm = instant(rng);
+        CHECK_EQ(jumping.offset(tm), reference_offset(tm / 1000));
+    }
+}
+
+/*---------------------------------------------------------------------------*/
+
+} // namespace
+
+int
+main()
+{
+    std::mt19937 rng(1);
+    for (auto rule : tz::ALL_ZONES) {
+        setenv("TZ", (std::string(":") + rule->name).c_str(), 1);
+        tzset();
+        int failures = check::failures;
+        check_zone(*rule, rng);
+        printf("%-20s %s\n", rule->name, check::failures == failures ? "ok" : "FAILED");
+    }
+    return check_result();
+}
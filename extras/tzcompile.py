@@ -0,0 +1,234 @@
+#!/usr/bin/env python3
+#
+#    Copyright 2023 Zach Vonler
+#
+#    This file is part of CircuitPlaygroundChronometer.
+#
+#    CircuitPlaygroundChronometer is free software: you can redistribute it
+#    and/or modify it under the terms of the GNU General Public License as
+#    published by the Free Software Foundation, either version 3 of the License,
+#    or (at your option) any later version.
+#
+#    CircuitPlaygroundChronometer is distributed in the hope that it will be
+#    useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+#    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General
+#    Public License for more details.
+#
+#    You should have received a copy of the GNU General Public License along with
+#    CircuitPlaygroundChronometer.  If not, see <https://www.gnu.org/licenses/>.
+
+"""
+Compiles the current rules for a subset of the tz database into the
+TimeZoneRule tables in src/TimeZoneRules.{h,cpp}.
+
+The rules are taken from the POSIX TZ footer of each zone's TZif file, so
+only zones whose footer uses the "Mm.w.d" transition form are supported.
+Before anything is written, the compiled rules are evaluated with the same
+algorithm TimeZone.cpp uses and compared against the host's zoneinfo for
+every half hour of the verified years, plus the instants around each
+transition.
+
+Usage: extras/tzcompile.py [--zoneinfo DIR] [--years FIRST LAST] [ZONE ...]
+"""
+
+import argparse
+import datetime
+import os
+import re
+import sys
+import zoneinfo
+
+DEFAULT_ZONES = [
+    "America/New_York",
+    "America/Chicago",
+    "America/Denver",
+    "America/Phoenix",
+    "America/Los_Angeles",
+    "America/Anchorage",
+    "America/St_Johns",
+    "Pacific/Honolulu",
+    "Europe/London",
+    "Europe/Berlin",
+    "Asia/Kolkata",
+    "Asia/Tokyo",
+    "Australia/Sydney",
+    "Pacific/Auckland",
+    "UTC",
+]
+
+SRC_DIR = os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", "src")
+
+LICENSE = """/*
+    Copyright 2023 Zach Vonler
+
+    This file is part of CircuitPlaygroundChronometer.
+
+    CircuitPlaygroundChronometer is free software: you can redistribute it
+    and/or modify it under the terms of the GNU General Public License as
+    published by the Free Software Foundation, either version 3 of the License,
+    or (at your option) any later version.
+
+    CircuitPlaygroundChronometer is distributed in the hope that it will be
+    useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General
+    Public License for more details.
+
+    You should have received a copy of the GNU General Public License along with
+    CircuitPlaygroundChronometer.  If not, see <https://www.gnu.org/licenses/>.
+*/
+"""
+
+#-----------------------------------------------------------------------------
+
+def read_posix_footer(path):
+    with open(path, "rb") as f:
+        data = f.read()
+    if not data.startswith(b"TZif") or data[4:5] == b"\0":
+        raise ValueError(f"{path}: not a version 2+ TZif file")
+    footer = data.rstrip(b"\n").rsplit(b"\n", 1)[-1]
+    return footer.decode("ascii")
+
+def parse_hms(text):
+    sign = -1 if text.startswith("-") else 1
+    parts = [int(p) for p in text.lstrip("+-").split(":")]
+    parts += [0] * (3 - len(parts))
+    return sign * (parts[0] * 3600 + parts[1] * 60 + parts[2])
+
+NAME = r"(?:[A-Za-z]{3,}|<[^>]+>)"
+OFFSET = r"[+-]?\d{1,3}(?::\d{2}){0,2}"
+RULE = r"M(\d{1,2})\.(\d)\.(\d)(?:/(" + OFFSET + r"))?"
+POSIX_TZ = re.compile(
+    rf"^{NAME}({OFFSET})(?:{NAME}({OFFSET})?,{RULE},{RULE})?$")
+
+def parse_posix_tz(tz):
+    """
+    Returns (std_offset, dst_offset, dst_start, dst_end) with offsets in
+    seconds east of UTC and each transition as (month, week, weekday, seconds
+    after local midnight).
+    """
+    m = POSIX_TZ.match(tz)
+    if not m:
+        raise ValueError(f"unsupported POSIX TZ string '{tz}'")
+    g = m.groups()
+    std_offset = -parse_hms(g[0])
+    if g[2] is None:
+        return std_offset, std_offset, (0, 0, 0, 0), (0, 0, 0, 0)
+    dst_offset = -parse_hms(g[1]) if g[1] else std_offset + 3600
+    def rule(month, week, weekday, time):
+        return (int(month), int(week), int(weekday), parse_hms(time) if time else 7200)
+    return std_offset, dst_offset, rule(*g[2:6]), rule(*g[6:10])
+
+#-----------------------------------------------------------------------------
+# Mirrors of the algorithms in TimeZone.cpp, used for verification.
+
+def days_from_civil(y, m, d):
+    y -= m <= 2
+    era = (y if y >= 0 else y - 399) // 400
+    yoe = y - era * 400
+    doy = (153 * (m + (-3 if m > 2 else 9)) + 2) // 5 + d - 1
+    doe = yoe * 365 + yoe // 4 - yoe // 100 + doy
+    return era * 146097 + doe - 719468
+
+def transition_local_s(year, rule):
+    month, week, weekday, time = rule
+    first = days_from_civil(year, month, 1)
+    next_month = days_from_civil(year + (month == 12), month % 12 + 1, 1)
+    day = first + (weekday - (first + 4) % 7 + 7) % 7 + (week - 1) * 7
+    while day >= next_month:
+        day -= 7
+    return day * 86400 + time
+
+def compiled_offset(rule, utc_s):
+    std_offset, dst_offset, start, end = rule
+    if std_offset == dst_offset:
+        return std_offset
+    year = datetime.datetime.fromtimestamp(utc_s, datetime.timezone.utc).year
+    transitions = []
+    for y in (year - 1, year, year + 1):
+        transitions.append((transition_local_s(y, start) - std_offset, dst_offset))
+        transitions.append((transition_local_s(y, end) - dst_offset, std_offset))
+    transitions.sort()
+    offset = transitions[0][1]
+    for tm, after in transitions:
+        if tm > utc_s:
+            break
+        offset = after
+    return offset
+
+def verify(name, rule, first_year, last_year):
+    zone = zoneinfo.ZoneInfo(name)
+    start = int(datetime.datetime(first_year, 1, 1, tzinfo=datetime.timezone.utc).timestamp())
+    stop = int(datetime.datetime(last_year + 1, 1, 1, tzinfo=datetime.timezone.utc).timestamp())
+    instants = list(range(start, stop, 1800))
+    if rule[0] != rule[1]:
+        for year in range(first_year, last_year + 1):
+            for tm in (transition_local_s(year, rule[2]) - rule[0],
+                       transition_local_s(year, rule[3]) - rule[1]):
+                instants += [tm - 1, tm, tm + 1]
+    for utc_s in instants:
+        dt = datetime.datetime.fromtimestamp(utc_s, datetime.timezone.utc)
+        expected = int(dt.astimezone(zone).utcoffset().total_seconds())
+        actual = compiled_offset(rule, utc_s)
+        if expected != actual:
+            raise ValueError(f"{name}: offset at {dt.isoformat()} is {actual}, zoneinfo says {expected}")
+
+#-----------------------------------------------------------------------------
+
+def identifier(zone):
+    return re.sub(r"[^A-Za-z0-9]", "_", zone)
+
+def write_header(zones, path):
+    with open(path, "w") as f:
+        f.write(LICENSE)
+        f.write("\n// Generated by extras/tzcompile.py, do not edit.\n\n")
+        f.write("#ifndef time_zone_rules_h\n#define time_zone_rules_h\n\n")
+        f.write('#include "TimeZone.h"\n\nnamespace cp_chrono {\nnamespace tz {\n\n')
+        f.write("/*" + "-" * 75 + "*/\n\n")
+        for zone, _, _ in zones:
+            f.write(f"extern const TimeZoneRule {identifier(zone)};\n")
+        f.write("\n// Every zone above, in the order they were compiled\n")
+        f.write(f"constexpr int NUM_ZONES = {len(zones)};\n")
+        f.write("extern const TimeZoneRule* const ALL_ZONES[NUM_ZONES];\n")
+        f.write("\n/*" + "-" * 75 + "*/\n\n")
+        f.write("} // namespace tz\n} // namespace cp_chrono\n\n#endif\n")
+
+def write_source(zones, path):
+    def rule(r):
+        return "{ %2d, %d, %d, %6d }" % r
+    with open(path, "w") as f:
+        f.write(LICENSE)
+        f.write("\n// Generated by extras/tzcompile.py, do not edit.\n\n")
+        f.write('#include "TimeZoneRules.h"\n\nnamespace cp_chrono {\nnamespace tz {\n\n')
+        f.write("/*" + "-" * 75 + "*/\n\n")
+        for zone, tz, (std_offset, dst_offset, start, end) in zones:
+            f.write(f"// {tz}\n")
+            f.write(f"const TimeZoneRule {identifier(zone)} = {{\n")
+            f.write(f'    "{zone}", {std_offset}, {dst_offset},\n')
+            f.write(f"    {rule(start)},\n    {rule(end)},\n}};\n\n")
+        f.write("const TimeZoneRule* const ALL_ZONES[NUM_ZONES] = {\n")
+        for zone, _, _ in zones:
+            f.write(f"    &{identifier(zone)},\n")
+        f.write("};\n\n")
+        f.write("/*" + "-" * 75 + "*/\n\n")
+        f.write("} // namespace tz\n} // namespace cp_chrono\n")
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.strip().splitlines()[0])
+    parser.add_argument("--zoneinfo", default="/usr/share/zoneinfo")
+    parser.add_argument("--years", nargs=2, type=int, default=[2020, 2040], metavar=("FIRST", "LAST"))
+    parser.add_argument("zones", nargs="*", default=DEFAULT_ZONES)
+    args = parser.parse_args()
+
+    compiled = []
+    for zone in args.zones:
+        tz = read_posix_footer(os.path.join(args.zoneinfo, zone))
+        rule = parse_posix_tz(tz)
+        verify(zone, rule, *args.years)
+        compiled.append((zone, tz, rule))
+        print(f"{zone}: {tz}", file=sys.stderr)
+
+    write_header(compiled, os.path.join(SRC_DIR, "TimeZoneRules.h"))
+    write_source(compiled, os.path.join(SRC_DIR, "TimeZoneRules.cpp"))
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,137 @@
+/*
+    Copyright 2023 Zach Vonler
+
+    This file is part of CircuitPlaygroundChronometer.
+
+    CircuitPlaygroundChronometer is free software: you can redistribute it
+    and/or modify it under the terms of the GNU General Public License as
+    published by the Free Software Foundation, either version 3 of the License,
+    or (at your option) any later version.
+
+    CircuitPlaygroundChronometer is distributed in the hope that it will be
+    useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General
+    Public License for more details.
+
+    You should have received a copy of the GNU General Public License along with
+    CircuitPlaygroundChronometer.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "AlarmSchedule.h"
+
+namespace {
+
+/*---------------------------------------------------------------------------*/
+
+constexpr int64_t MS_PER_DAY = 86400LL * 1000;
+
+int64_t day_start(int64_t tm)
+{
+    int64_t days = tm / MS_PER_DAY - (tm % MS_PER_DAY < 0);
+    return days * MS_PER_DAY;
+}
+
+/*---------------------------------------------------------------------------*/
+
+} // anonymous namespace
+
+namespace cp_chrono {
+
+/*---------------------------------------------------------------------------*/
+
+void
+AlarmSchedule::reschedule(int64_t tm)
+{
+    _now_tm = tm;
+    if (!_size) {
+        _next_fire_tm = INT64_MAX;
+        return;
+    }
+
+    // Binary search for the first alarm later in the day than tm
+    auto today_tm = day_start(tm);
+    uint16_t minute = (tm - today_tm) / (60 * 1000);
+    int lo = 0;
+    int hi = _size;
+    while (lo < hi) {
+        int mid = (lo + hi) / 2;
+        if (_minutes[mid] <= minute)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+
+    if (lo < _size) {
+        _next_index = lo;
+        _next_fire_tm = fire_tm(lo, today_tm);
+    } else {
+        _next_index = 0;
+        _next_fire_tm = fire_tm(0, today_tm + MS_PER_DAY);
+    }
+}
+
+bool
+AlarmSchedule::add(uint16_t minute_of_day)
+{
+    if (minute_of_day >= MINUTES_PER_DAY || _size == MAX_ALARMS)
+        return false;
+
+    int pos = _size;
+    while (pos > 0 && _minutes[pos - 1] > minute_of_day)
+        --pos;
+    if (pos > 0 && _minutes[pos - 1] == minute_of_day)
+        return false;
+
+    for (int i = _size; i > pos; --i)
+        _minutes[i] = _minutes[i - 1];
+    _minutes[pos] = minute_of_day;
+    ++_size;
+    ++_revision;
+
+    // The new alarm only becomes the next one if it fires before the current
+    // next one, otherwise the next index just shifts past it.
+    auto today_tm = day_start(_now_tm);
+    auto new_fire_tm = fire_tm(pos, today_tm);
+    if (new_fire_tm <= _now_tm)
+        new_fire_tm += MS_PER_DAY;
+    if (new_fire_tm < _next_fire_tm) {
+        _next_index = pos;
+        _next_fire_tm = new_fire_tm;
+    } else if (pos <= _next_index) {
+        ++_next_index;
+    }
+    return true;
+}
+
+bool
+AlarmSchedule::remove(uint16_t minute_of_day)
+{
+    int pos = 0;
+    while (pos < _size && _minutes[pos] != minute_of_day)
+        ++pos;
+    if (pos == _size)
+        return false;
+
+    --_size;
+    for (int i = pos; i < _size; ++i)
+        _minutes[i] = _minutes[i + 1];
+    ++_revision;
+
+    if (pos == _next_index)
+        reschedule(_now_tm);
+    else if (pos < _next_index)
+        --_next_index;
+    return true;
+}
+
+void
+AlarmSchedule::clear()
+{
+    _size = 0;
+    _next_fire_tm = INT64_MAX;
+    ++_revision;
+}
+
+/*---------------------------------------------------------------------------*/
+
+} // namespace cp_chrono
@@ -0,0 +1,107 @@
+/*
+    Copyright 2023 Zach Vonler
+
+    This file is part of CircuitPlaygroundChronometer.
+
+    CircuitPlaygroundChronometer is free software: you can redistribute it
+    and/or modify it under the terms of the GNU General Public License as
+    published by the Free Software Foundation, either version 3 of the License,
+    or (at your option) any later version.
+
+    CircuitPlaygroundChronometer is distributed in the hope that it will be
+    useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General
+    Public License for more details.
+
+    You should have received a copy of the GNU General Public License along with
+    CircuitPlaygroundChronometer.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef alarm_schedule_h
+#define alarm_schedule_h
+
+#include <stdint.h>
+
+namespace cp_chrono {
+
+/*---------------------------------------------------------------------------*/
+
+/**
+ * A table of daily alarms, each identified by the minute of the day it fires
+ * at in display time. The table is kept sorted, and the index and time of the
+ * next alarm to fire are maintained as alarms are added and removed, so that
+ * checking for a due alarm is a single comparison.
+ */
+class AlarmSchedule
+{
+public:
+    constexpr static int MAX_ALARMS = 32;
+    constexpr static uint16_t MINUTES_PER_DAY = 24 * 60;
+
+    /**
+     * Updates the schedule to display time tm. Returns true if an alarm
+     * became due, in which case the schedule advances to the next alarm after
+     * tm. Alarms skipped over by a jump in display time do not fire.
+     */
+    bool update(int64_t tm)
+    {
+        _now_tm = tm;
+        if (tm < _next_fire_tm)
+            return false;
+        reschedule(tm);
+        return true;
+    }
+
+    /**
+     * Recomputes the next alarm after display time tm. Must be called when
+     * display time changes other than by moving forward, e.g. when the clock
+     * offset is adjusted. After display time moves backward, passing the time
+     * before the move keeps alarms that already fired from firing again as
+     * display time catches up.
+     */
+    void reschedule(int64_t tm);
+
+    /**
+     * Adds an alarm at minute_of_day. Returns false if the minute is out of
+     * range, already has an alarm, or the table is full.
+     */
+    bool add(uint16_t minute_of_day);
+
+    /**
+     * Removes the alarm at minute_of_day. Returns false if there was none.
+     */
+    bool remove(uint16_t minute_of_day);
+
+    void clear();
+
+    // Returns the number of alarms in the table.
+    int size() const { return _size; }
+
+    // Returns the minute of the day of the i-th alarm, in time of day order.
+    uint16_t alarm(int i) const { return _minutes[i]; }
+
+    // Returns the display time of the next alarm, or INT64_MAX if none.
+    int64_t next_fire_tm() const { return _next_fire_tm; }
+
+    // Incremented whenever the table is changed, to detect the need to save it.
+    uint16_t revision() const { return _revision; }
+
+private:
+    int64_t fire_tm(int index, int64_t day_start_tm) const
+    {
+        return day_start_tm + _minutes[index] * 60 * 1000LL;
+    }
+
+    uint16_t _minutes[MAX_ALARMS];
+    int _size = 0;
+    int _next_index = 0;
+    int64_t _next_fire_tm = INT64_MAX;
+    int64_t _now_tm = 0;
+    uint16_t _revision = 0;
+};
+
+/*---------------------------------------------------------------------------*/
+
+} // namespace cp_chrono
+
+#endif
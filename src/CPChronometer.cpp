@@ -18,37 +18,37 @@
 */
 
 #include "CPChronometer.h"
+#include "PixelKernels.h"
 
-#include <Adafruit_CircuitPlayground.h>
-#include <CircuitPlaygroundGestures.h>
 #include <FastLED.h>
 
 namespace cp_chrono {
 
-using CPG = CircuitPlaygroundGestures;
+using HW = HardwareContext;
 
 /*---------------------------------------------------------------------------*/
 
-CPChronometer::CPChronometer()
-    : _clock_display(_pixels, NUM_PIXELS, LED_BUILTIN)
-    , _timer_display(_pixels, NUM_PIXELS, MS_PER_PIXEL, LED_BUILTIN)
+CPChronometer::CPChronometer(HardwareContext& hardware)
+    : _hardware(hardware)
+    , _clock_display(_pixels, NUM_PIXELS, &hardware)
+    , _timer_display(_pixels, NUM_PIXELS, MS_PER_PIXEL, &hardware)
+    , _power_monitor(TypicalLEDStrip)
 { }
 
 void
 CPChronometer::begin()
 {
-    _led_controller = &FastLED.addLeds<WS2811, CPLAY_NEOPIXELPIN, GRB>(_pixels, NUM_PIXELS);
-    _led_controller->setCorrection(TypicalLEDStrip);
-    pinMode(LED_BUILTIN, OUTPUT);
-    CircuitPlaygroundGestures::instance().begin();
+    _hardware.begin(_pixels, NUM_PIXELS, TypicalLEDStrip);
 }
 
 void
 CPChronometer::reset(int64_t tm)
 {
-    _mode = CircuitPlayground.slideSwitch() ? CLOCK : TIMER;
+    _mode = _hardware.slide_switch() ? CLOCK : TIMER;
     _timer_display.reset();
     _clock_display.reset(tm);
+    _alarms_display_offset = _clock_display.display_tm(tm) - tm;
+    _alarms.reschedule(tm + _alarms_display_offset);
 }
 
 void
@@ -58,9 +58,24 @@ CPChronometer::update(int64_t now)
 
     if (_timer_display.update(now)) {
         // Timer ran out
-        CircuitPlayground.playTone(700, 150);
-        CircuitPlayground.playTone(650, 50);
-        CircuitPlayground.playTone(700, 100);
+        _hardware.play_tone(700, 150);
+        _hardware.play_tone(650, 50);
+        _hardware.play_tone(700, 100);
+    }
+
+    check_alarms(now);
+
+    bool was_blanked = _blanked;
+    check_motion(now);
+    if (_blanked) {
+        if (!was_blanked) {
+            // Clear the display once, then leave it alone until woken
+            pixel_kernels::fill_solid(_pixels, NUM_PIXELS, 0);
+            _hardware.set_indicator(false);
+            _hardware.show_leds(0);
+        }
+        _power_monitor.account(PowerMonitor::BLANKED, _pixels, NUM_PIXELS, 0, now);
+        return;
     }
 
     if (_mode == CLOCK) {
@@ -69,23 +84,87 @@ CPChronometer::update(int64_t now)
         _timer_display.show(now);
     }
 
-    _led_controller->showLeds(BRIGHTNESS);
+    auto brightness = _power_monitor.account(power_category(), _pixels, NUM_PIXELS, BRIGHTNESS, now);
+    _hardware.show_leds(brightness);
+}
+
+PowerMonitor::Category
+CPChronometer::power_category() const
+{
+    if (_mode == CLOCK)
+        return PowerMonitor::CLOCK;
+    else if (_timer_display.timeout_running())
+        return PowerMonitor::COUNT_DOWN;
+    else if (_timer_display.timer_running())
+        return PowerMonitor::COUNT_UP;
+    else
+        return PowerMonitor::IDLE;
+}
+
+void
+CPChronometer::check_alarms(int64_t now)
+{
+    constexpr int64_t MS_PER_DAY = 86400LL * 1000;
+
+    // Any change to the clock offset or time zone moves every alarm's
+    // deadline, so the schedule is recomputed instead of firing alarms that
+    // the display time jumped over.
+    auto display_tm = _clock_display.display_tm(now);
+    auto offset_change = (display_tm - now) - _alarms_display_offset;
+    if (offset_change) {
+        _alarms_display_offset = display_tm - now;
+
+        // Only the time of day matters, and the clock offset wraps by a day
+        // when it goes negative, so treat the change as the shortest move
+        // around the clock face.
+        offset_change %= MS_PER_DAY;
+        if (offset_change > MS_PER_DAY / 2)
+            offset_change -= MS_PER_DAY;
+        else if (offset_change <= -MS_PER_DAY / 2)
+            offset_change += MS_PER_DAY;
+
+        // When the time of day moved backward, e.g. at the end of daylight
+        // saving time, schedule from the time of day before the change so
+        // the alarms in the repeated interval don't fire a second time.
+        _alarms.reschedule(display_tm - min(offset_change, int64_t(0)));
+    } else if (_alarms.update(display_tm)) {
+        _hardware.play_tone(880, 200);
+        _hardware.play_tone(660, 200);
+        _hardware.play_tone(880, 200);
+    }
+}
+
+void
+CPChronometer::check_motion(int64_t now)
+{
+    float x, y, z;
+    _hardware.read_acceleration(x, y, z);
+    auto state = _motion_monitor.update(now, x, y, z);
+
+    // A still board is left lit while a running timer is on display
+    bool timer_shown = _mode == TIMER
+        && (_timer_display.timer_running() || _timer_display.timeout_running());
+    _blanked = state == MotionMonitor::FACE_DOWN
+        || (state == MotionMonitor::STILL && !timer_shown);
 }
 
 void
 CPChronometer::check_for_gesture(int64_t now)
 {
-    auto& cpg = CircuitPlaygroundGestures::instance();
+    auto gesture = _hardware.update_gestures(now);
 
-    auto gesture = cpg.update(now);
+    // Any input wakes a blanked display. Button input on a blanked display
+    // does nothing else, since the user can't see what it would change.
+    if (gesture != HW::NO_GESTURE)
+        _motion_monitor.wake(now);
 
-    if (gesture == CPG::SLIDE_SWITCHED_ON) {
+    if (gesture == HW::SLIDE_SWITCHED_ON) {
         if (_mode != CLOCK) {
             _mode = CLOCK;
             _clock_display.reset(now);
         }
         return;
-    } else if (gesture == CPG::SLIDE_SWITCHED_OFF) {
+    } else if (gesture == HW::SLIDE_SWITCHED_OFF) {
         // Switch in TIMER mode position, see if that's new
         if (_mode != TIMER) {
             _mode = TIMER;
@@ -93,20 +172,23 @@ CPChronometer::check_for_gesture(int64_t now)
         return;
     }
 
+    if (_blanked)
+        return;
+
     // Other gestures cause adjustments, so don't do them too often
     if (now - _last_adjustment_tm < 250)
         return;
 
     bool adjusted = false;
     if (_mode == CPChronometer::CLOCK) {
-        if (gesture == CPG::LEFT_HELD_RIGHT_CLICKED) {
+        if (gesture == HW::LEFT_HELD_RIGHT_CLICKED) {
             _clock_display.increase_offset(60 * 1000);
             adjusted = true;
-        } else if (gesture == CPG::RIGHT_HELD_LEFT_CLICKED) {
+        } else if (gesture == HW::RIGHT_HELD_LEFT_CLICKED) {
             _clock_display.increase_offset(-60 * 1000);
             adjusted = true;
-        } else if (cpg.both_pressed() && cpg.duration(now) >= 500) {
-            auto duration = cpg.duration(now);
+        } else if (_hardware.both_pressed() && _hardware.duration(now) >= 500) {
+            auto duration = _hardware.duration(now);
             int64_t increase = 0;
             if (duration < 1000) {
                 increase = 60 * 1000;
@@ -115,31 +197,33 @@ CPChronometer::check_for_gesture(int64_t now)
             } else {
                 increase = 3600 * 1000;
             }
-            auto sign = cpg.left_duration(now) > cpg.right_duration(now) ? 1 : -1;
+            auto sign = _hardware.left_duration(now) > _hardware.right_duration(now) ? 1 : -1;
             _clock_display.increase_offset(sign * increase);
             adjusted = true;
         }
     } else {
-        if (gesture == CPG::RIGHT_CLICKED) {
+        if (gesture == HW::RIGHT_CLICKED) {
             if (!_timer_display.timer_running()) {
                 _timer_display.set_timeout(now, _timer_display.timeout_remaining(now) + MS_PER_PIXEL);
                 adjusted = true;
             }
-        } else if (gesture == CPG::LEFT_CLICKED) {
+        } else if (gesture == HW::LEFT_CLICKED) {
             if (!_timer_display.timeout_running()) {
                 if (!_timer_display.timer_running()) {
                     _timer_display.start_timer(now);
                     adjusted = true;
                 }
             }
-        } else if (gesture == CPG::BOTH_PRESSED) {
+        } else if (gesture == HW::BOTH_PRESSED) {
             _timer_display.reset();
             _timer_display.clear_timeout();
             adjusted = true;
         }
     }
-    if (adjusted)
+    if (adjusted) {
         _last_adjustment_tm = now;
+        _motion_monitor.wake(now);
+    }
 }
 
 /*---------------------------------------------------------------------------*/
@@ -20,8 +20,13 @@
 #ifndef cp_chronometer_h
 #define cp_chronometer_h
 
+#include "AlarmSchedule.h"
 #include "ClockDisplay.h"
+#include "HardwareContext.h"
+#include "MotionMonitor.h"
+#include "PowerMonitor.h"
 #include "TimerDisplay.h"
+#include "TimeZone.h"
 
 namespace cp_chrono {
 
@@ -29,7 +34,7 @@ namespace cp_chrono {
 
 /**
  * Implements a chronometer with clock and timer functions on the Adafruit
- * Circuit Playground.
+ * Circuit Playground, or on any other HardwareContext.
  */
 class CPChronometer {
 public:
@@ -39,9 +44,9 @@ public:
     };
 
     /**
-     * Instantiates the chronometer.
+     * Instantiates the chronometer on hardware, which must outlive it.
      */
-    CPChronometer();
+    CPChronometer(HardwareContext& hardware);
 
     /**
      * Initializes LEDs, should be called once from setup().
@@ -68,9 +73,30 @@ public:
     // Adds the adjustment to the clock offset.
     void increase_clock_offset(int32_t adjustment) { _clock_display.increase_offset(adjustment); }
 
+    // Sets the time zone the clock displays, the tm values passed to update()
+    // must then be UTC. The clock offset is applied on top of the zone's.
+    void set_time_zone(const TimeZone* time_zone) { _clock_display.set_time_zone(time_zone); }
+
     // Returns the time the clock would display at tm (i.e. tm adjusted by the clock's offset)
     int64_t clock_display_tm(int64_t tm) const { return _clock_display.display_tm(tm); }
 
+    // Returns the daily alarms, which fire in either mode at the clock's
+    // display time.
+    AlarmSchedule& alarms() { return _alarms; }
+    const AlarmSchedule& alarms() const { return _alarms; }
+
+    // Returns the NeoPixel power accounting, which can also limit the
+    // NeoPixels to a current budget.
+    PowerMonitor& power_monitor() { return _power_monitor; }
+    const PowerMonitor& power_monitor() const { return _power_monitor; }
+
+    // Returns true if the display is blanked because the board is face down,
+    // or has been still without a running timer on display.
+    bool display_blanked() const { return _blanked; }
+
+    // Returns how long to wait before the next call to update().
+    uint32_t frame_interval_ms() const { return _blanked ? BLANKED_FRAME_INTERVAL_MS : FRAME_INTERVAL_MS; }
+
     // The number of NeoPixels available
     constexpr static int NUM_PIXELS = 10;
 
@@ -80,16 +106,31 @@ public:
     // The maximum countup or countdown timer value
     constexpr static uint32_t MAX_TIMEOUT = MS_PER_PIXEL * NUM_PIXELS;
 
-    constexpr static uint8_t BRIGHTNESS = 8;
+    // The brightness the NeoPixels are shown at, before any current limiting
+    constexpr static uint8_t BRIGHTNESS = 6;
+
+    // The update interval while the display is shown, and while it is
+    // blanked. The buttons are still polled while blanked, so the slow tick
+    // must be short enough not to miss a click.
+    constexpr static uint32_t FRAME_INTERVAL_MS = 1000 / 120;
+    constexpr static uint32_t BLANKED_FRAME_INTERVAL_MS = 30;
 
 private:
     void check_for_gesture(int64_t now);
+    void check_alarms(int64_t now);
+    void check_motion(int64_t now);
+    PowerMonitor::Category power_category() const;
 
     Mode _mode = CLOCK;
-    CRGB _pixels[NUM_PIXELS];
-    CLEDController* _led_controller;
+    HardwareContext& _hardware;
+    alignas(4) CRGB _pixels[NUM_PIXELS]; // Aligned for the pixel kernels
     ClockDisplay _clock_display;
     TimerDisplay _timer_display;
+    AlarmSchedule _alarms;
+    PowerMonitor _power_monitor;
+    MotionMonitor _motion_monitor;
+    bool _blanked = false;
+    int64_t _alarms_display_offset = 0;
     int64_t _last_adjustment_tm = 0;
 };
 
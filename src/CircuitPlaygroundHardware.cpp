@@ -0,0 +1,118 @@
+/*
+    Copyright 2023 Zach Vonler
+
+    This file is part of CircuitPlaygroundChronometer.
+
+    CircuitPlaygroundChronometer is free software: you can redistribute it
+    and/or modify it under the terms of the GNU General Public License as
+    published by the Free Software Foundation, either version 3 of the License,
+    or (at your option) any later version.
+
+    CircuitPlaygroundChronometer is distributed in the hope that it will be
+    useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General
+    Public License for more details.
+
+    You should have received a copy of the GNU General Public License along with
+    CircuitPlaygroundChronometer.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "CircuitPlaygroundHardware.h"
+
+#include <Adafruit_CircuitPlayground.h>
+#include <CircuitPlaygroundGestures.h>
+#include <FastLED.h>
+
+namespace cp_chrono {
+
+using CPG = CircuitPlaygroundGestures;
+
+/*---------------------------------------------------------------------------*/
+
+void
+CircuitPlaygroundHardware::begin(CRGB* pixels, int num_pixels, CRGB correction)
+{
+    _led_controller = &FastLED.addLeds<WS2811, CPLAY_NEOPIXELPIN, GRB>(pixels, num_pixels);
+    _led_controller->setCorrection(correction);
+    pinMode(LED_BUILTIN, OUTPUT);
+    CPG::instance().begin();
+}
+
+void
+CircuitPlaygroundHardware::show_leds(uint8_t brightness)
+{
+    _led_controller->showLeds(brightness);
+}
+
+void
+CircuitPlaygroundHardware::set_indicator(bool on)
+{
+    digitalWrite(LED_BUILTIN, on);
+}
+
+void
+CircuitPlaygroundHardware::play_tone(uint16_t frequency, uint16_t duration)
+{
+    CircuitPlayground.playTone(frequency, duration);
+}
+
+bool
+CircuitPlaygroundHardware::slide_switch()
+{
+    return CircuitPlayground.slideSwitch();
+}
+
+void
+CircuitPlaygroundHardware::read_acceleration(float& x, float& y, float& z)
+{
+    // One read for all three axes, the motionX/Y/Z() accessors each read the
+    // accelerometer separately.
+    sensors_event_t event;
+    CircuitPlayground.lis.getEvent(&event);
+    x = event.acceleration.x;
+    y = event.acceleration.y;
+    z = event.acceleration.z;
+}
+
+HardwareContext::Gesture
+CircuitPlaygroundHardware::update_gestures(int64_t now)
+{
+    switch (CPG::instance().update(now)) {
+    case CPG::SLIDE_SWITCHED_ON:       return SLIDE_SWITCHED_ON;
+    case CPG::SLIDE_SWITCHED_OFF:      return SLIDE_SWITCHED_OFF;
+    case CPG::LEFT_CLICKED:            return LEFT_CLICKED;
+    case CPG::RIGHT_CLICKED:           return RIGHT_CLICKED;
+    case CPG::BOTH_PRESSED:            return BOTH_PRESSED;
+    case CPG::LEFT_HELD_RIGHT_CLICKED: return LEFT_HELD_RIGHT_CLICKED;
+    case CPG::RIGHT_HELD_LEFT_CLICKED: return RIGHT_HELD_LEFT_CLICKED;
+    default:                           return NO_GESTURE;
+    }
+}
+
+bool
+CircuitPlaygroundHardware::both_pressed()
+{
+    return CPG::instance().both_pressed();
+}
+
+uint32_t
+CircuitPlaygroundHardware::duration(int64_t now)
+{
+    return CPG::instance().duration(now);
+}
+
+uint32_t
+CircuitPlaygroundHardware::left_duration(int64_t now)
+{
+    return CPG::instance().left_duration(now);
+}
+
+uint32_t
+CircuitPlaygroundHardware::right_duration(int64_t now)
+{
+    return CPG::instance().right_duration(now);
+}
+
+/*---------------------------------------------------------------------------*/
+
+} // namespace cp_chrono
@@ -0,0 +1,57 @@
+/*
+    Copyright 2023 Zach Vonler
+
+    This file is part of CircuitPlaygroundChronometer.
+
+    CircuitPlaygroundChronometer is free software: you can redistribute it
+    and/or modify it under the terms of the GNU General Public License as
+    published by the Free Software Foundation, either version 3 of the License,
+    or (at your option) any later version.
+
+    CircuitPlaygroundChronometer is distributed in the hope that it will be
+    useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General
+    Public License for more details.
+
+    You should have received a copy of the GNU General Public License along with
+    CircuitPlaygroundChronometer.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef circuit_playground_hardware_h
+#define circuit_playground_hardware_h
+
+#include "HardwareContext.h"
+
+namespace cp_chrono {
+
+/*---------------------------------------------------------------------------*/
+
+/**
+ * The Adafruit Circuit Playground's built-in NeoPixels, LED, speaker,
+ * accelerometer, buttons and slide switch. There should be only one of these
+ * per board.
+ */
+class CircuitPlaygroundHardware : public HardwareContext
+{
+public:
+    void begin(CRGB* pixels, int num_pixels, CRGB correction) override;
+    void show_leds(uint8_t brightness) override;
+    void set_indicator(bool on) override;
+    void play_tone(uint16_t frequency, uint16_t duration) override;
+    bool slide_switch() override;
+    void read_acceleration(float& x, float& y, float& z) override;
+    Gesture update_gestures(int64_t now) override;
+    bool both_pressed() override;
+    uint32_t duration(int64_t now) override;
+    uint32_t left_duration(int64_t now) override;
+    uint32_t right_duration(int64_t now) override;
+
+private:
+    CLEDController* _led_controller = nullptr;
+};
+
+/*---------------------------------------------------------------------------*/
+
+} // namespace cp_chrono
+
+#endif
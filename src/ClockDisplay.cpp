@@ -18,6 +18,7 @@
 */
 
 #include "ClockDisplay.h"
+#include "PixelKernels.h"
 #include "Utils.h"
 
 namespace {
@@ -146,7 +147,7 @@ void display_time(ClockDisplay& clock, uint32_t elapsed, uint32_t duration)
     show_hour_indicator(clock, elapsed, duration);
 
     // Minute indicator slowly pulses
-    clock.addToNumeral(clock.now_5_minute(), colorFadedBy(clock.minute_color(), beatsin8(12, 0, 200)));
+    clock.addToNumeral(clock.now_5_minute(), colorFadedBy(clock.minute_color(), beatsin8_at(elapsed, 12, 0, 200)));
 
     // Seconds indicator flashes at 1Hz
     if (elapsed % 1000 > 500)
@@ -171,12 +172,12 @@ ClockDisplay::orientation_stages[] = {
 void
 ClockDisplay::update(int64_t now)
 {
-    _now_tm = now + _offset;
-    fadeToBlackBy(_pixels, _num_pixels, 40);
+    _now_tm = display_tm(now);
+    pixel_kernels::fade_to_black_by(_pixels, _num_pixels, 40);
 
-    if (_ampm_indicator_pin >= 0) {
+    if (_ampm_indicator) {
         // Turn indicator on for PM
-        digitalWrite(_ampm_indicator_pin, !now_is_am());
+        _ampm_indicator->set_indicator(!now_is_am());
     }
 
     auto anim_tm = _now_tm - _reset_tm;
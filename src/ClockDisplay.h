@@ -20,6 +20,9 @@
 #ifndef clock_display_h
 #define clock_display_h
 
+#include "HardwareContext.h"
+#include "TimeZone.h"
+
 #include <FastLED.h>
 #include <RTClib.h>
 
@@ -34,16 +37,17 @@ class ClockDisplay
 {
     CRGB* _pixels;
     int _num_pixels;
-    int _ampm_indicator_pin;
+    HardwareContext* _ampm_indicator;
     int64_t _offset = 0;
+    const TimeZone* _time_zone = nullptr;
     int64_t _reset_tm = 0;
     int64_t _now_tm = 0;
 
 public:
-    ClockDisplay(CRGB* pixels, int num_pixels, int ampm_indicator_pin = -1)
+    ClockDisplay(CRGB* pixels, int num_pixels, HardwareContext* ampm_indicator = nullptr)
         : _pixels(pixels)
         , _num_pixels(num_pixels)
-        , _ampm_indicator_pin(ampm_indicator_pin)
+        , _ampm_indicator(ampm_indicator)
     { }
 
     int64_t offset() const { return _offset; }
@@ -55,14 +59,18 @@ public:
             _offset += 86400 * 1000;
     }
 
+    // Sets the time zone whose offset is applied in addition to the clock's
+    // own offset, or clears it if time_zone is null.
+    void set_time_zone(const TimeZone* time_zone) { _time_zone = time_zone; }
+
     int64_t display_tm(int64_t tm) const
     {
-        return tm + _offset;
+        return tm + _offset + (_time_zone ? _time_zone->offset(tm) : 0);
     }
 
     void reset(int64_t reset_tm)
     {
-        _reset_tm = reset_tm + _offset;
+        _reset_tm = display_tm(reset_tm);
     }
 
     void update(int64_t now);
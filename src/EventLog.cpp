@@ -0,0 +1,59 @@
+/*
+    Copyright 2023 Zach Vonler
+
+    This file is part of CircuitPlaygroundChronometer.
+
+    CircuitPlaygroundChronometer is free software: you can redistribute it
+    and/or modify it under the terms of the GNU General Public License as
+    published by the Free Software Foundation, either version 3 of the License,
+    or (at your option) any later version.
+
+    CircuitPlaygroundChronometer is distributed in the hope that it will be
+    useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General
+    Public License for more details.
+
+    You should have received a copy of the GNU General Public License along with
+    CircuitPlaygroundChronometer.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "EventLog.h"
+
+namespace cp_chrono {
+
+/*---------------------------------------------------------------------------*/
+
+int
+EventLog::drain(Print& out, Formatter format)
+{
+    int written = 0;
+    while (_line.length || format_next(format)) {
+        if (out.availableForWrite() < _line.length)
+            break;
+        out.write(_line.line, _line.length);
+        _line.length = 0;
+        ++written;
+    }
+    return written;
+}
+
+bool
+EventLog::format_next(Formatter format)
+{
+    if (_dropped != _reported_dropped) {
+        _line.print("(dropped ");
+        _line.print(_dropped - _reported_dropped);
+        _line.println(" log records)");
+        _reported_dropped = _dropped;
+    } else if (_head != _tail) {
+        (*format)(_line, _records[_tail & (CAPACITY - 1)]);
+        ++_tail;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+/*---------------------------------------------------------------------------*/
+
+} // namespace cp_chrono
@@ -0,0 +1,126 @@
+/*
+    Copyright 2023 Zach Vonler
+
+    This file is part of CircuitPlaygroundChronometer.
+
+    CircuitPlaygroundChronometer is free software: you can redistribute it
+    and/or modify it under the terms of the GNU General Public License as
+    published by the Free Software Foundation, either version 3 of the License,
+    or (at your option) any later version.
+
+    CircuitPlaygroundChronometer is distributed in the hope that it will be
+    useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General
+    Public License for more details.
+
+    You should have received a copy of the GNU General Public License along with
+    CircuitPlaygroundChronometer.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef event_log_h
+#define event_log_h
+
+#include <Arduino.h>
+
+namespace cp_chrono {
+
+/*---------------------------------------------------------------------------*/
+
+/**
+ * Records compact binary log entries into a RAM ring so that the main loop
+ * never blocks on the serial port. Formatting is deferred to drain(), which
+ * formats one line at a time into a buffer and only writes it once the output
+ * can accept the whole line without blocking. When the ring is full, new
+ * records are dropped and counted rather than waiting for space.
+ */
+class EventLog
+{
+public:
+    struct Record
+    {
+        uint32_t tm;     // Low 32 bits of the millisecond timestamp
+        uint8_t event;   // Caller-defined event id
+        int32_t args[3]; // Raw, unformatted arguments
+    };
+
+    // Writes a human-readable form of a record to the output.
+    using Formatter = void (*)(Print&, const Record&);
+
+    // The number of records the ring holds, must be a power of two
+    constexpr static uint8_t CAPACITY = 32;
+
+    // The longest formatted line, longer lines are truncated. Kept below the
+    // 63 bytes of write space the SAMD USB serial port reports when idle, since
+    // a line is only written once the output has room for all of it.
+    constexpr static uint8_t MAX_LINE = 60;
+
+    /**
+     * Appends a record to the ring, or counts it as dropped if the ring is
+     * full. Cheap enough to call from the hot path.
+     */
+    void log(uint8_t event, int64_t tm, int32_t a0 = 0, int32_t a1 = 0, int32_t a2 = 0)
+    {
+        if (uint8_t(_head - _tail) == CAPACITY) {
+            ++_dropped;
+            return;
+        }
+        auto& record = _records[_head & (CAPACITY - 1)];
+        record.tm = uint32_t(tm);
+        record.event = event;
+        record.args[0] = a0;
+        record.args[1] = a1;
+        record.args[2] = a2;
+        ++_head;
+    }
+
+    /**
+     * Formats pending records and writes each line to out, for as long as out
+     * has write space for the whole line. A line that doesn't fit is kept
+     * and written by a later call. Returns the number of lines written.
+     */
+    int drain(Print& out, Formatter format);
+
+    // Returns the number of records waiting to be drained.
+    uint8_t pending() const { return _head - _tail; }
+
+    // Returns the total number of records dropped because the ring was full.
+    uint32_t dropped() const { return _dropped; }
+
+private:
+    // Collects the output of a formatter so its length is known before any of
+    // it is written.
+    class LineBuffer : public Print
+    {
+    public:
+        using Print::write;
+
+        size_t write(uint8_t c) override
+        {
+            if (length == MAX_LINE)
+                return 0;
+            line[length++] = c;
+            return 1;
+        }
+
+        uint8_t line[MAX_LINE];
+        uint8_t length = 0;
+    };
+
+    bool format_next(Formatter format);
+
+    static_assert((CAPACITY & (CAPACITY - 1)) == 0, "CAPACITY must be a power of two");
+    static_assert(CAPACITY <= 128, "CAPACITY must fit the 8-bit ring indices");
+
+    Record _records[CAPACITY];
+    uint8_t _head = 0;
+    uint8_t _tail = 0;
+    uint32_t _dropped = 0;
+    uint32_t _reported_dropped = 0;
+    LineBuffer _line;
+};
+
+/*---------------------------------------------------------------------------*/
+
+} // namespace cp_chrono
+
+#endif
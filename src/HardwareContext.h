@@ -0,0 +1,89 @@
+/*
+    Copyright 2023 Zach Vonler
+
+    This file is part of CircuitPlaygroundChronometer.
+
+    CircuitPlaygroundChronometer is free software: you can redistribute it
+    and/or modify it under the terms of the GNU General Public License as
+    published by the Free Software Foundation, either version 3 of the License,
+    or (at your option) any later version.
+
+    CircuitPlaygroundChronometer is distributed in the hope that it will be
+    useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General
+    Public License for more details.
+
+    You should have received a copy of the GNU General Public License along with
+    CircuitPlaygroundChronometer.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef hardware_context_h
+#define hardware_context_h
+
+#include <FastLED.h>
+
+namespace cp_chrono {
+
+/*---------------------------------------------------------------------------*/
+
+/**
+ * The hardware a chronometer reads its input from and displays its output on.
+ * Each chronometer uses only the context it is constructed with, so several
+ * can run side by side against simulated hardware.
+ */
+class HardwareContext
+{
+public:
+    enum Gesture {
+        NO_GESTURE,
+        SLIDE_SWITCHED_ON,
+        SLIDE_SWITCHED_OFF,
+        LEFT_CLICKED,
+        RIGHT_CLICKED,
+        BOTH_PRESSED,
+        LEFT_HELD_RIGHT_CLICKED,
+        RIGHT_HELD_LEFT_CLICKED,
+    };
+
+    virtual ~HardwareContext() { }
+
+    /**
+     * Prepares the hardware to show pixels with the color correction applied.
+     * Called once from the chronometer's begin().
+     */
+    virtual void begin(CRGB* pixels, int num_pixels, CRGB correction) = 0;
+
+    // Shows the pixels passed to begin() at brightness.
+    virtual void show_leds(uint8_t brightness) = 0;
+
+    // Turns the single indicator LED on or off.
+    virtual void set_indicator(bool on) = 0;
+
+    // Plays a tone, returning when it has finished.
+    virtual void play_tone(uint16_t frequency, uint16_t duration) = 0;
+
+    // Returns true if the slide switch is in the clock position.
+    virtual bool slide_switch() = 0;
+
+    // Reads the accelerometer, in m/s^2.
+    virtual void read_acceleration(float& x, float& y, float& z) = 0;
+
+    // Processes button and switch input at now, returning any new gesture.
+    virtual Gesture update_gestures(int64_t now) = 0;
+
+    // Returns true if both buttons are currently pressed.
+    virtual bool both_pressed() = 0;
+
+    // Returns how long the current button state has lasted at now.
+    virtual uint32_t duration(int64_t now) = 0;
+
+    // Return how long each button has been pressed at now.
+    virtual uint32_t left_duration(int64_t now) = 0;
+    virtual uint32_t right_duration(int64_t now) = 0;
+};
+
+/*---------------------------------------------------------------------------*/
+
+} // namespace cp_chrono
+
+#endif
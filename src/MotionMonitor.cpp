@@ -0,0 +1,57 @@
+/*
+    Copyright 2023 Zach Vonler
+
+    This file is part of CircuitPlaygroundChronometer.
+
+    CircuitPlaygroundChronometer is free software: you can redistribute it
+    and/or modify it under the terms of the GNU General Public License as
+    published by the Free Software Foundation, either version 3 of the License,
+    or (at your option) any later version.
+
+    CircuitPlaygroundChronometer is distributed in the hope that it will be
+    useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General
+    Public License for more details.
+
+    You should have received a copy of the GNU General Public License along with
+    CircuitPlaygroundChronometer.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "MotionMonitor.h"
+
+namespace cp_chrono {
+
+/*---------------------------------------------------------------------------*/
+
+MotionMonitor::State
+MotionMonitor::update(int64_t now, float x, float y, float z)
+{
+    float dx = x - _ref_x;
+    float dy = y - _ref_y;
+    float dz = z - _ref_z;
+    if (dx * dx + dy * dy + dz * dz > MOTION_THRESHOLD * MOTION_THRESHOLD || !_last_motion_tm) {
+        _ref_x = x;
+        _ref_y = y;
+        _ref_z = z;
+        _last_motion_tm = now;
+    }
+
+    if (z < FACE_DOWN_Z) {
+        if (!_face_down_tm)
+            _face_down_tm = now;
+    } else {
+        _face_down_tm = 0;
+    }
+
+    if (_face_down_tm && now - _face_down_tm >= FACE_DOWN_DELAY)
+        _state = FACE_DOWN;
+    else if (now - _last_motion_tm >= STILL_DELAY)
+        _state = STILL;
+    else
+        _state = ACTIVE;
+    return _state;
+}
+
+/*---------------------------------------------------------------------------*/
+
+} // namespace cp_chrono
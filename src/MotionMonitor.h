@@ -0,0 +1,89 @@
+/*
+    Copyright 2023 Zach Vonler
+
+    This file is part of CircuitPlaygroundChronometer.
+
+    CircuitPlaygroundChronometer is free software: you can redistribute it
+    and/or modify it under the terms of the GNU General Public License as
+    published by the Free Software Foundation, either version 3 of the License,
+    or (at your option) any later version.
+
+    CircuitPlaygroundChronometer is distributed in the hope that it will be
+    useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General
+    Public License for more details.
+
+    You should have received a copy of the GNU General Public License along with
+    CircuitPlaygroundChronometer.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef motion_monitor_h
+#define motion_monitor_h
+
+#include <stdint.h>
+
+namespace cp_chrono {
+
+/*---------------------------------------------------------------------------*/
+
+/**
+ * Tracks the board's orientation and motion from accelerometer readings to
+ * decide when nobody can be looking at the display. The board is considered
+ * face down once gravity has pointed out of its face for a moment, and still
+ * once no reading has moved away from the last moving one for a while. Any
+ * movement or turning over makes it active again on the same reading.
+ */
+class MotionMonitor
+{
+public:
+    enum State {
+        ACTIVE,
+        STILL,
+        FACE_DOWN,
+    };
+
+    // Readings along Z below this, in m/s^2, mean the face points down
+    constexpr static float FACE_DOWN_Z = -7.0;
+
+    // Readings that differ by more than this, in m/s^2, mean the board moved
+    constexpr static float MOTION_THRESHOLD = 1.0;
+
+    // How long the face must point down before the board is FACE_DOWN
+    constexpr static uint32_t FACE_DOWN_DELAY = 2 * 1000;
+
+    // How long the board must not move before it is STILL
+    constexpr static uint32_t STILL_DELAY = 2 * 60 * 1000;
+
+    /**
+     * Updates the state with an accelerometer reading in m/s^2 taken at now,
+     * and returns the new state.
+     */
+    State update(int64_t now, float x, float y, float z);
+
+    /**
+     * Makes the state ACTIVE as if the board had just moved, e.g. when a
+     * button is pressed.
+     */
+    void wake(int64_t now)
+    {
+        _last_motion_tm = now;
+        _face_down_tm = 0;
+        _state = ACTIVE;
+    }
+
+    State state() const { return _state; }
+
+private:
+    State _state = ACTIVE;
+    float _ref_x = 0;
+    float _ref_y = 0;
+    float _ref_z = 0;
+    int64_t _last_motion_tm = 0;
+    int64_t _face_down_tm = 0;
+};
+
+/*---------------------------------------------------------------------------*/
+
+} // namespace cp_chrono
+
+#endif
@@ -0,0 +1,173 @@
+/*
+    Copyright 2023 Zach Vonler
+
+    This file is part of CircuitPlaygroundChronometer.
+
+    CircuitPlaygroundChronometer is free software: you can redistribute it
+    and/or modify it under the terms of the GNU General Public License as
+    published by the Free Software Foundation, either version 3 of the License,
+    or (at your option) any later version.
+
+    CircuitPlaygroundChronometer is distributed in the hope that it will be
+    useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General
+    Public License for more details.
+
+    You should have received a copy of the GNU General Public License along with
+    CircuitPlaygroundChronometer.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef pixel_kernels_h
+#define pixel_kernels_h
+
+#include <FastLED.h>
+#include <string.h>
+
+// Define CP_CHRONO_SCALAR_PIXEL_KERNELS to use FastLED's per-pixel functions
+// instead of the word-parallel versions. Scaling is only word-parallel when
+// FastLED uses the fixed scale8(), so that results are bit-exact.
+#if !defined(CP_CHRONO_SCALAR_PIXEL_KERNELS) && FASTLED_SCALE8_FIXED == 1
+#define CP_CHRONO_SWAR_PIXEL_KERNELS 1
+#endif
+
+namespace cp_chrono {
+
+/*---------------------------------------------------------------------------*/
+
+/**
+ * Pixel buffer operations that give the same results as FastLED's, but work
+ * on four color channels per 32-bit word. Channels before the first word
+ * boundary and after the last are handled one at a time, so buffers aligned
+ * to 4 bytes are fastest.
+ */
+namespace pixel_kernels {
+
+namespace detail {
+
+inline uint32_t load_word(const uint8_t* p)
+{
+    uint32_t w;
+    memcpy(&w, __builtin_assume_aligned(p, 4), 4);
+    return w;
+}
+
+inline void store_word(uint8_t* p, uint32_t w)
+{
+    memcpy(__builtin_assume_aligned(p, 4), &w, 4);
+}
+
+// Scales each byte of w by (scale + 1) / 256, as the fixed scale8() does. Each
+// 16-bit lane holds one channel, so products cannot carry into the next.
+inline uint32_t scale_word(uint32_t w, uint16_t scale_fixed)
+{
+    uint32_t even = ((w & 0x00FF00FF) * scale_fixed >> 8) & 0x00FF00FF;
+    uint32_t odd = ((w >> 8 & 0x00FF00FF) * scale_fixed) & 0xFF00FF00;
+    return even | odd;
+}
+
+// Adds each byte of a and b, saturating at 255 as qadd8() does.
+inline uint32_t qadd_word(uint32_t a, uint32_t b)
+{
+    // Add the low seven bits of each byte, which can't carry across bytes,
+    // then fix up the top bits and saturate the bytes that carried out.
+    uint32_t low_sum = (a & 0x7F7F7F7F) + (b & 0x7F7F7F7F);
+    uint32_t sum = low_sum ^ ((a ^ b) & 0x80808080);
+    uint32_t carry = ((a & b) | ((a ^ b) & low_sum)) & 0x80808080;
+    return sum | ((carry >> 7) * 0xFF);
+}
+
+inline uint8_t* align_up(uint8_t* p)
+{
+    return p + (-reinterpret_cast<uintptr_t>(p) & 3);
+}
+
+} // namespace detail
+
+/**
+ * Scales each channel by scale / 256, equivalent to nscale8().
+ */
+inline void scale(CRGB* pixels, int num_pixels, uint8_t amount)
+{
+#ifdef CP_CHRONO_SWAR_PIXEL_KERNELS
+    if (num_pixels <= 0)
+        return;
+    uint16_t scale_fixed = uint16_t(amount) + 1;
+    auto p = reinterpret_cast<uint8_t*>(pixels);
+    auto end = p + num_pixels * 3;
+    auto words = detail::align_up(p);
+    for (; p < words && p < end; ++p)
+        *p = (*p * scale_fixed) >> 8;
+    for (; p + 4 <= end; p += 4)
+        detail::store_word(p, detail::scale_word(detail::load_word(p), scale_fixed));
+    for (; p < end; ++p)
+        *p = (*p * scale_fixed) >> 8;
+#else
+    nscale8(pixels, num_pixels, amount);
+#endif
+}
+
+/**
+ * Fades each channel toward black by fade_by / 256, equivalent to
+ * fadeToBlackBy().
+ */
+inline void fade_to_black_by(CRGB* pixels, int num_pixels, uint8_t fade_by)
+{
+    scale(pixels, num_pixels, 255 - fade_by);
+}
+
+/**
+ * Sets every pixel to color, equivalent to fill_solid().
+ */
+inline void fill_solid(CRGB* pixels, int num_pixels, const CRGB& color)
+{
+#ifdef CP_CHRONO_SWAR_PIXEL_KERNELS
+    if (color.r == color.g && color.g == color.b) {
+        if (num_pixels > 0)
+            memset(static_cast<void*>(pixels), color.r, num_pixels * 3);
+        return;
+    }
+#endif
+    ::fill_solid(pixels, num_pixels, color);
+}
+
+/**
+ * Adds color to every pixel, saturating each channel at 255, equivalent to
+ * adding it to each pixel with the CRGB += operator.
+ */
+inline void add(CRGB* pixels, int num_pixels, const CRGB& color)
+{
+#ifdef CP_CHRONO_SWAR_PIXEL_KERNELS
+    if (num_pixels <= 0)
+        return;
+    auto start = reinterpret_cast<uint8_t*>(pixels);
+    auto end = start + num_pixels * 3;
+    auto words = detail::align_up(start);
+    auto p = start;
+    for (; p < words && p < end; ++p)
+        *p = qadd8(*p, color.raw[(p - start) % 3]);
+
+    // Byte i of the buffer gets color channel i % 3, so from the first word
+    // boundary the color repeats every three words.
+    uint8_t pattern_bytes[12];
+    for (int i = 0; i < 12; ++i)
+        pattern_bytes[i] = color.raw[(words - start + i) % 3];
+    uint32_t pattern[3];
+    memcpy(pattern, pattern_bytes, sizeof(pattern));
+    for (int i = 0; p + 4 <= end; p += 4, i = i == 2 ? 0 : i + 1)
+        detail::store_word(p, detail::qadd_word(detail::load_word(p), pattern[i]));
+
+    for (; p < end; ++p)
+        *p = qadd8(*p, color.raw[(p - start) % 3]);
+#else
+    for (int i = 0; i < num_pixels; ++i)
+        pixels[i] += color;
+#endif
+}
+
+} // namespace pixel_kernels
+
+/*---------------------------------------------------------------------------*/
+
+} // namespace cp_chrono
+
+#endif
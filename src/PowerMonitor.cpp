@@ -0,0 +1,86 @@
+/*
+    Copyright 2023 Zach Vonler
+
+    This file is part of CircuitPlaygroundChronometer.
+
+    CircuitPlaygroundChronometer is free software: you can redistribute it
+    and/or modify it under the terms of the GNU General Public License as
+    published by the Free Software Foundation, either version 3 of the License,
+    or (at your option) any later version.
+
+    CircuitPlaygroundChronometer is distributed in the hope that it will be
+    useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General
+    Public License for more details.
+
+    You should have received a copy of the GNU General Public License along with
+    CircuitPlaygroundChronometer.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "PowerMonitor.h"
+
+namespace cp_chrono {
+
+/*---------------------------------------------------------------------------*/
+
+uint32_t
+PowerMonitor::estimate_ua(const CRGB* pixels, int num_pixels, uint8_t brightness) const
+{
+    // Each channel's duty cycle is its value scaled by the color correction
+    // and the brightness.
+    uint32_t sum = 0;
+    for (int i = 0; i < num_pixels; ++i) {
+        sum += pixels[i].r * _correction.r
+             + pixels[i].g * _correction.g
+             + pixels[i].b * _correction.b;
+    }
+    uint64_t lit_ua = uint64_t(sum) * brightness * CHANNEL_UA / (255UL * 255 * 255);
+    return lit_ua + num_pixels * PIXEL_QUIESCENT_UA;
+}
+
+uint8_t
+PowerMonitor::account(Category category, const CRGB* pixels, int num_pixels, uint8_t brightness, int64_t now)
+{
+    if (_last_tm && now > _last_tm) {
+        auto& last = _totals[_last_category];
+        // Don't charge long gaps, e.g. before the first update, at full rate
+        uint32_t elapsed = min(now - _last_tm, int64_t(1000));
+        last.charge += uint64_t(_last_ua) * elapsed;
+        last.duration += elapsed;
+    }
+
+    auto& totals = _totals[category];
+    ++totals.frames;
+
+    uint32_t ua = estimate_ua(pixels, num_pixels, brightness);
+    uint32_t budget_ua = _budget_ma * 1000UL;
+    uint32_t quiescent_ua = num_pixels * PIXEL_QUIESCENT_UA;
+    if (_budget_ma && ua > budget_ua && budget_ua > quiescent_ua) {
+        // The lit current is proportional to brightness
+        brightness = uint64_t(brightness) * (budget_ua - quiescent_ua) / (ua - quiescent_ua);
+        ua = estimate_ua(pixels, num_pixels, brightness);
+        ++totals.limited_frames;
+    }
+
+    _last_category = category;
+    _last_ua = ua;
+    _last_tm = now;
+    return brightness;
+}
+
+const char*
+PowerMonitor::category_name(Category category)
+{
+    switch (category) {
+    case CLOCK:      return "clock";
+    case COUNT_UP:   return "count-up";
+    case COUNT_DOWN: return "countdown";
+    case IDLE:       return "idle";
+    case BLANKED:    return "blanked";
+    default:         return "unknown";
+    }
+}
+
+/*---------------------------------------------------------------------------*/
+
+} // namespace cp_chrono
@@ -0,0 +1,108 @@
+/*
+    Copyright 2023 Zach Vonler
+
+    This file is part of CircuitPlaygroundChronometer.
+
+    CircuitPlaygroundChronometer is free software: you can redistribute it
+    and/or modify it under the terms of the GNU General Public License as
+    published by the Free Software Foundation, either version 3 of the License,
+    or (at your option) any later version.
+
+    CircuitPlaygroundChronometer is distributed in the hope that it will be
+    useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General
+    Public License for more details.
+
+    You should have received a copy of the GNU General Public License along with
+    CircuitPlaygroundChronometer.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef power_monitor_h
+#define power_monitor_h
+
+#include <FastLED.h>
+
+namespace cp_chrono {
+
+/*---------------------------------------------------------------------------*/
+
+/**
+ * Estimates the current drawn by the NeoPixels from the values about to be
+ * shown, and accumulates the charge used per display category. Optionally
+ * limits the brightness of frames that would exceed a current budget.
+ */
+class PowerMonitor
+{
+public:
+    enum Category {
+        CLOCK,
+        COUNT_UP,
+        COUNT_DOWN,
+        IDLE,
+        BLANKED,
+        NUM_CATEGORIES,
+    };
+
+    struct Totals
+    {
+        uint64_t charge = 0;      // In microamp-milliseconds
+        uint64_t duration = 0;    // In milliseconds
+        uint32_t frames = 0;
+        uint32_t limited_frames = 0;
+
+        // Returns the charge used in microamp-hours.
+        uint32_t charge_uah() const { return charge / (3600ULL * 1000); }
+
+        // Returns the average current in microamps.
+        uint32_t average_ua() const { return duration ? charge / duration : 0; }
+    };
+
+    // Current drawn by one fully lit color channel
+    constexpr static uint32_t CHANNEL_UA = 20000;
+
+    // Current drawn by one pixel's driver when dark
+    constexpr static uint32_t PIXEL_QUIESCENT_UA = 600;
+
+    PowerMonitor(CRGB correction = CRGB(255, 255, 255))
+        : _correction(correction)
+    { }
+
+    /**
+     * Sets the current budget for the NeoPixels in milliamps, or disables
+     * the limit if budget_ma is 0.
+     */
+    void set_budget_ma(uint16_t budget_ma) { _budget_ma = budget_ma; }
+    uint16_t budget_ma() const { return _budget_ma; }
+
+    /**
+     * Returns the estimated current in microamps drawn by pixels when shown
+     * at brightness.
+     */
+    uint32_t estimate_ua(const CRGB* pixels, int num_pixels, uint8_t brightness) const;
+
+    /**
+     * Accounts for the frame about to be shown at now, charging the time since
+     * the previous frame to the previous frame's category. Returns the
+     * brightness to show the frame at, which is lower than brightness if the
+     * frame would exceed the budget.
+     */
+    uint8_t account(Category category, const CRGB* pixels, int num_pixels, uint8_t brightness, int64_t now);
+
+    const Totals& totals(Category category) const { return _totals[category]; }
+
+    static const char* category_name(Category category);
+
+private:
+    CRGB _correction;
+    uint16_t _budget_ma = 0;
+    Category _last_category = IDLE;
+    uint32_t _last_ua = 0;
+    int64_t _last_tm = 0;
+    Totals _totals[NUM_CATEGORIES];
+};
+
+/*---------------------------------------------------------------------------*/
+
+} // namespace cp_chrono
+
+#endif
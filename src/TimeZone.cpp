@@ -0,0 +1,129 @@
+/*
+    Copyright 2023 Zach Vonler
+
+    This file is part of CircuitPlaygroundChronometer.
+
+    CircuitPlaygroundChronometer is free software: you can redistribute it
+    and/or modify it under the terms of the GNU General Public License as
+    published by the Free Software Foundation, either version 3 of the License,
+    or (at your option) any later version.
+
+    CircuitPlaygroundChronometer is distributed in the hope that it will be
+    useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General
+    Public License for more details.
+
+    You should have received a copy of the GNU General Public License along with
+    CircuitPlaygroundChronometer.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "TimeZone.h"
+
+namespace {
+
+/*---------------------------------------------------------------------------*/
+
+constexpr int64_t MS_PER_DAY = 86400LL * 1000;
+
+int64_t floor_div(int64_t a, int64_t b)
+{
+    return a / b - ((a % b != 0) && ((a < 0) != (b < 0)));
+}
+
+// Returns the number of days from 1970-01-01 to the given date (proleptic
+// Gregorian), using Howard Hinnant's days_from_civil algorithm.
+int64_t days_from_civil(int32_t y, uint32_t m, uint32_t d)
+{
+    y -= m <= 2;
+    int32_t era = (y >= 0 ? y : y - 399) / 400;
+    uint32_t yoe = y - era * 400;
+    uint32_t doy = (153 * (m > 2 ? m - 3 : m + 9) + 2) / 5 + d - 1;
+    uint32_t doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    return int64_t(era) * 146097 + doe - 719468;
+}
+
+// Returns the year containing the day that is the given number of days after
+// 1970-01-01, the inverse of days_from_civil.
+int32_t year_from_days(int64_t z)
+{
+    z += 719468;
+    int64_t era = (z >= 0 ? z : z - 146096) / 146097;
+    uint32_t doe = z - era * 146097;
+    uint32_t yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    uint32_t doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    uint32_t mp = (5 * doy + 2) / 153;
+    return yoe + era * 400 + (mp >= 10);
+}
+
+// Returns the local time in ms at which the rule's transition occurs in year.
+int64_t transition_local_tm(int32_t year, const cp_chrono::TransitionRule& rule)
+{
+    int64_t first = days_from_civil(year, rule.month, 1);
+    int64_t next_month = rule.month == 12
+        ? days_from_civil(year + 1, 1, 1)
+        : days_from_civil(year, rule.month + 1, 1);
+    // 1970-01-01 was a Thursday
+    int first_weekday = (first % 7 + 7 + 4) % 7;
+    int64_t day = first + (rule.weekday - first_weekday + 7) % 7 + (rule.week - 1) * 7;
+    while (day >= next_month)
+        day -= 7;
+    return day * MS_PER_DAY + int64_t(rule.time) * 1000;
+}
+
+/*---------------------------------------------------------------------------*/
+
+} // anonymous namespace
+
+namespace cp_chrono {
+
+/*---------------------------------------------------------------------------*/
+
+void
+TimeZone::update_cache(int64_t utc_tm) const
+{
+    if (_rule.std_offset == _rule.dst_offset) {
+        _offset = _rule.std_offset * 1000;
+        _valid_from_tm = INT64_MIN;
+        _next_transition_tm = INT64_MAX;
+        return;
+    }
+
+    struct Transition
+    {
+        int64_t tm;
+        int32_t offset_after;
+    };
+
+    // The transitions of the surrounding years always bracket utc_tm, even
+    // when it falls near a new year.
+    Transition transitions[6];
+    int32_t year = year_from_days(floor_div(utc_tm, MS_PER_DAY));
+    int n = 0;
+    for (int32_t y = year - 1; y <= year + 1; ++y) {
+        transitions[n++] = { transition_local_tm(y, _rule.dst_start) - _rule.std_offset * 1000LL,
+                             _rule.dst_offset * 1000 };
+        transitions[n++] = { transition_local_tm(y, _rule.dst_end) - _rule.dst_offset * 1000LL,
+                             _rule.std_offset * 1000 };
+    }
+
+    // Insertion sort, the southern hemisphere's transitions are not in
+    // start/end order within a year.
+    for (int i = 1; i < n; ++i) {
+        for (int j = i; j > 0 && transitions[j].tm < transitions[j - 1].tm; --j) {
+            auto t = transitions[j];
+            transitions[j] = transitions[j - 1];
+            transitions[j - 1] = t;
+        }
+    }
+
+    int i = 1;
+    while (i < n - 1 && transitions[i].tm <= utc_tm)
+        ++i;
+    _offset = transitions[i - 1].offset_after;
+    _valid_from_tm = transitions[i - 1].tm;
+    _next_transition_tm = transitions[i].tm;
+}
+
+/*---------------------------------------------------------------------------*/
+
+} // namespace cp_chrono
@@ -0,0 +1,93 @@
+/*
+    Copyright 2023 Zach Vonler
+
+    This file is part of CircuitPlaygroundChronometer.
+
+    CircuitPlaygroundChronometer is free software: you can redistribute it
+    and/or modify it under the terms of the GNU General Public License as
+    published by the Free Software Foundation, either version 3 of the License,
+    or (at your option) any later version.
+
+    CircuitPlaygroundChronometer is distributed in the hope that it will be
+    useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General
+    Public License for more details.
+
+    You should have received a copy of the GNU General Public License along with
+    CircuitPlaygroundChronometer.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef time_zone_h
+#define time_zone_h
+
+#include <stdint.h>
+
+namespace cp_chrono {
+
+/*---------------------------------------------------------------------------*/
+
+/**
+ * A POSIX-style "Mm.w.d/time" rule for the day and time a daylight saving
+ * transition occurs each year.
+ */
+struct TransitionRule
+{
+    uint8_t month;   // 1-12
+    uint8_t week;    // 1-5, with 5 meaning the last week of the month
+    uint8_t weekday; // 0-6, with 0 meaning Sunday
+    int32_t time;    // Seconds after local midnight, may be negative or past 24h
+};
+
+/**
+ * The current rules for a time zone, compiled from the tz database by
+ * extras/tzcompile.py. Offsets are in seconds east of UTC. A zone without
+ * daylight saving time has equal offsets and its transition rules are unused.
+ */
+struct TimeZoneRule
+{
+    const char* name;
+    int32_t std_offset;
+    int32_t dst_offset;
+    TransitionRule dst_start; // In local standard time
+    TransitionRule dst_end;   // In local daylight saving time
+};
+
+/**
+ * Converts UTC times to local times using a TimeZoneRule. The offset in effect
+ * is cached along with the UTC times of the surrounding transitions, so the
+ * rules are only evaluated again when a transition is crossed.
+ */
+class TimeZone
+{
+public:
+    TimeZone(const TimeZoneRule& rule)
+        : _rule(rule)
+    { }
+
+    const TimeZoneRule& rule() const { return _rule; }
+
+    // Returns the number of milliseconds to add to utc_tm to get local time.
+    int32_t offset(int64_t utc_tm) const
+    {
+        if (utc_tm < _valid_from_tm || utc_tm >= _next_transition_tm)
+            update_cache(utc_tm);
+        return _offset;
+    }
+
+    // Returns the UTC time of the first transition after the cached one.
+    int64_t next_transition_tm() const { return _next_transition_tm; }
+
+private:
+    void update_cache(int64_t utc_tm) const;
+
+    const TimeZoneRule& _rule;
+    mutable int32_t _offset = 0;
+    mutable int64_t _valid_from_tm = 0;
+    mutable int64_t _next_transition_tm = 0;
+};
+
+/*---------------------------------------------------------------------------*/
+
+} // namespace cp_chrono
+
+#endif
@@ -0,0 +1,155 @@
+/*
+    Copyright 2023 Zach Vonler
+
+    This file is part of CircuitPlaygroundChronometer.
+
+    CircuitPlaygroundChronometer is free software: you can redistribute it
+    and/or modify it under the terms of the GNU General Public License as
+    published by the Free Software Foundation, either version 3 of the License,
+    or (at your option) any later version.
+
+    CircuitPlaygroundChronometer is distributed in the hope that it will be
+    useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General
+    Public License for more details.
+
+    You should have received a copy of the GNU General Public License along with
+    CircuitPlaygroundChronometer.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+// Generated by extras/tzcompile.py, do not edit.
+
+#include "TimeZoneRules.h"
+
+namespace cp_chrono {
+namespace tz {
+
+/*---------------------------------------------------------------------------*/
+
+// EST5EDT,M3.2.0,M11.1.0
+const TimeZoneRule America_New_York = {
+    "America/New_York", -18000, -14400,
+    {  3, 2, 0,   7200 },
+    { 11, 1, 0,   7200 },
+};
+
+// CST6CDT,M3.2.0,M11.1.0
+const TimeZoneRule America_Chicago = {
+    "America/Chicago", -21600, -18000,
+    {  3, 2, 0,   7200 },
+    { 11, 1, 0,   7200 },
+};
+
+// MST7MDT,M3.2.0,M11.1.0
+const TimeZoneRule America_Denver = {
+    "America/Denver", -25200, -21600,
+    {  3, 2, 0,   7200 },
+    { 11, 1, 0,   7200 },
+};
+
+// MST7
+const TimeZoneRule America_Phoenix = {
+    "America/Phoenix", -25200, -25200,
+    {  0, 0, 0,      0 },
+    {  0, 0, 0,      0 },
+};
+
+// PST8PDT,M3.2.0,M11.1.0
+const TimeZoneRule America_Los_Angeles = {
+    "America/Los_Angeles", -28800, -25200,
+    {  3, 2, 0,   7200 },
+    { 11, 1, 0,   7200 },
+};
+
+// AKST9AKDT,M3.2.0,M11.1.0
+const TimeZoneRule America_Anchorage = {
+    "America/Anchorage", -32400, -28800,
+    {  3, 2, 0,   7200 },
+    { 11, 1, 0,   7200 },
+};
+
+// NST3:30NDT,M3.2.0,M11.1.0
+const TimeZoneRule America_St_Johns = {
+    "America/St_Johns", -12600, -9000,
+    {  3, 2, 0,   7200 },
+    { 11, 1, 0,   7200 },
+};
+
+// HST10
+const TimeZoneRule Pacific_Honolulu = {
+    "Pacific/Honolulu", -36000, -36000,
+    {  0, 0, 0,      0 },
+    {  0, 0, 0,      0 },
+};
+
+// GMT0BST,M3.5.0/1,M10.5.0
+const TimeZoneRule Europe_London = {
+    "Europe/London", 0, 3600,
+    {  3, 5, 0,   3600 },
+    { 10, 5, 0,   7200 },
+};
+
+// CET-1CEST,M3.5.0,M10.5.0/3
+const TimeZoneRule Europe_Berlin = {
+    "Europe/Berlin", 3600, 7200,
+    {  3, 5, 0,   7200 },
+    { 10, 5, 0,  10800 },
+};
+
+// IST-5:30
+const TimeZoneRule Asia_Kolkata = {
+    "Asia/Kolkata", 19800, 19800,
+    {  0, 0, 0,      0 },
+    {  0, 0, 0,      0 },
+};
+
+// JST-9
+const TimeZoneRule Asia_Tokyo = {
+    "Asia/Tokyo", 32400, 32400,
+    {  0, 0, 0,      0 },
+    {  0, 0, 0,      0 },
+};
+
+// AEST-10AEDT,M10.1.0,M4.1.0/3
+const TimeZoneRule Australia_Sydney = {
+    "Australia/Sydney", 36000, 39600,
+    { 10, 1, 0,   7200 },
+    {  4, 1, 0,  10800 },
+};
+
+// NZST-12NZDT,M9.5.0,M4.1.0/3
+const TimeZoneRule Pacific_Auckland = {
+    "Pacific/Auckland", 43200, 46800,
+    {  9, 5, 0,   7200 },
+    {  4, 1, 0,  10800 },
+};
+
+// UTC0
+const TimeZoneRule UTC = {
+    "UTC", 0, 0,
+    {  0, 0, 0,      0 },
+    {  0, 0, 0,      0 },
+};
+
+const TimeZoneRule* const ALL_ZONES[NUM_ZONES] = {
+    &America_New_York,
+    &America_Chicago,
+    &America_Denver,
+    &America_Phoenix,
+    &America_Los_Angeles,
+    &America_Anchorage,
+    &America_St_Johns,
+    &Pacific_Honolulu,
+    &Europe_London,
+    &Europe_Berlin,
+    &Asia_Kolkata,
+    &Asia_Tokyo,
+    &Australia_Sydney,
+    &Pacific_Auckland,
+    &UTC,
+};
+
+/*---------------------------------------------------------------------------*/
+
+} // namespace tz
+} // namespace cp_chrono
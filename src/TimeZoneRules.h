@@ -0,0 +1,57 @@
+/*
+    Copyright 2023 Zach Vonler
+
+    This file is part of CircuitPlaygroundChronometer.
+
+    CircuitPlaygroundChronometer is free software: you can redistribute it
+    and/or modify it under the terms of the GNU General Public License as
+    published by the Free Software Foundation, either version 3 of the License,
+    or (at your option) any later version.
+
+    CircuitPlaygroundChronometer is distributed in the hope that it will be
+    useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General
+    Public License for more details.
+
+    You should have received a copy of the GNU General Public License along with
+    CircuitPlaygroundChronometer.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+// Generated by extras/tzcompile.py, do not edit.
+
+#ifndef time_zone_rules_h
+#define time_zone_rules_h
+
+#include "TimeZone.h"
+
+namespace cp_chrono {
+namespace tz {
+
+/*---------------------------------------------------------------------------*/
+
+extern const TimeZoneRule America_New_York;
+extern const TimeZoneRule America_Chicago;
+extern const TimeZoneRule America_Denver;
+extern const TimeZoneRule America_Phoenix;
+extern const TimeZoneRule America_Los_Angeles;
+extern const TimeZoneRule America_Anchorage;
+extern const TimeZoneRule America_St_Johns;
+extern const TimeZoneRule Pacific_Honolulu;
+extern const TimeZoneRule Europe_London;
+extern const TimeZoneRule Europe_Berlin;
+extern const TimeZoneRule Asia_Kolkata;
+extern const TimeZoneRule Asia_Tokyo;
+extern const TimeZoneRule Australia_Sydney;
+extern const TimeZoneRule Pacific_Auckland;
+extern const TimeZoneRule UTC;
+
+// Every zone above, in the order they were compiled
+constexpr int NUM_ZONES = 15;
+extern const TimeZoneRule* const ALL_ZONES[NUM_ZONES];
+
+/*---------------------------------------------------------------------------*/
+
+} // namespace tz
+} // namespace cp_chrono
+
+#endif
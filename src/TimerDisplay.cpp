@@ -18,6 +18,7 @@
 */
 
 #include "TimerDisplay.h"
+#include "PixelKernels.h"
 #include "Utils.h"
 
 namespace cp_chrono {
@@ -50,9 +51,9 @@ TimerDisplay::show(int64_t tm)
     };
 
     if (timeout_running()) {
-        fill_solid(_pixels, _num_pixels, 0);
-        if (_heartbeat_indicator_pin >= 0)
-            digitalWrite(_heartbeat_indicator_pin, 0);
+        pixel_kernels::fill_solid(_pixels, _num_pixels, 0);
+        if (_heartbeat_indicator)
+            _heartbeat_indicator->set_indicator(false);
 
         int64_t remaining_ms = min(max_timeout(), timeout_remaining(tm));
         int num_lit = (remaining_ms - 1) / _ms_per_pixel;
@@ -77,8 +78,8 @@ TimerDisplay::show(int64_t tm)
             fadeToBlackBy(_pixels + PIXELS_CW_FROM_12_OCLOCK[num_lit], 1, (remaining_ms >> fade_div) % 256);
         }
     } else if (timer_running()) {
-        if (_heartbeat_indicator_pin >= 0)
-            digitalWrite(_heartbeat_indicator_pin, 0);
+        if (_heartbeat_indicator)
+            _heartbeat_indicator->set_indicator(false);
 
         int64_t elapsed_ms = timer_elapsed(tm);
         int num_lit = elapsed_ms / _ms_per_pixel;
@@ -92,7 +93,7 @@ TimerDisplay::show(int64_t tm)
         }
 
         auto num_incomplete = _num_pixels - num_lit;
-        fadeToBlackBy(_pixels + 1, num_incomplete - 1, 20);
+        pixel_kernels::fade_to_black_by(_pixels + 1, num_incomplete - 1, 20);
         auto idx_range = _num_pixels * 2;
         auto lit_pixel = (elapsed_ms / 125) % idx_range;
         if (lit_pixel < _num_pixels) {
@@ -101,9 +102,9 @@ TimerDisplay::show(int64_t tm)
             fadeToBlackBy(_pixels, 1, 8);
         }
     } else {
-        fill_solid(_pixels, _num_pixels, 0);
-        if (_heartbeat_indicator_pin >= 0)
-            digitalWrite(_heartbeat_indicator_pin, (tm % 1024) < 512);
+        pixel_kernels::fill_solid(_pixels, _num_pixels, 0);
+        if (_heartbeat_indicator)
+            _heartbeat_indicator->set_indicator((tm % 1024) < 512);
     }
 }
 
@@ -20,6 +20,8 @@
 #ifndef timer_display_h
 #define timer_display_h
 
+#include "HardwareContext.h"
+
 #include <FastLED.h>
 
 namespace cp_chrono {
@@ -35,11 +37,11 @@ namespace cp_chrono {
 class TimerDisplay
 {
 public:
-    TimerDisplay(CRGB* pixels, int num_pixels, uint32_t ms_per_pixel, int heartbeat_indicator_pin = -1)
+    TimerDisplay(CRGB* pixels, int num_pixels, uint32_t ms_per_pixel, HardwareContext* heartbeat_indicator = nullptr)
         : _pixels(pixels)
         , _num_pixels(num_pixels)
         , _ms_per_pixel(ms_per_pixel)
-        , _heartbeat_indicator_pin(heartbeat_indicator_pin)
+        , _heartbeat_indicator(heartbeat_indicator)
     { }
 
     /**
@@ -87,7 +89,7 @@ private:
 
     CRGB* _pixels;
     int _num_pixels;
-    int _heartbeat_indicator_pin;
+    HardwareContext* _heartbeat_indicator;
     uint32_t _ms_per_pixel;
     int64_t _timer_start_tm = 0;
     int64_t _timeout_tm = 0;
@@ -37,6 +37,16 @@ inline CRGB colorFadedBy(CRGB original, int fraction)
 
 /*---------------------------------------------------------------------------*/
 
+// Returns the same values as FastLED's beatsin8(), but driven by the
+// millisecond time tm instead of the system clock.
+inline uint8_t beatsin8_at(uint32_t tm, uint8_t bpm, uint8_t lowest, uint8_t highest)
+{
+    uint8_t beat = (tm * (uint32_t(bpm) << 8) * 280) >> 24;
+    return lowest + scale8(sin8(beat), highest - lowest);
+}
+
+/*---------------------------------------------------------------------------*/
+
 } // namespace cp_chrono
 
 #endif